@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/10/04 16:56:35 by maldavid          #+#    #+#             */
-/*   Updated: 2024/09/12 01:28:12 by tdelage          ###   ########.fr       */
+/*   Updated: 2026/10/19 04:22:47 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -32,6 +32,26 @@ typedef enum
 	MLX_WINDOW_EVENT = 5
 } mlx_event_type;
 
+typedef enum
+{
+	MLX_PRESENT_IMMEDIATE = 0,
+	MLX_PRESENT_MAILBOX = 1,
+	MLX_PRESENT_FIFO = 2
+} mlx_present_mode;
+
+typedef enum
+{
+	MLX_FILTER_NEAREST = 0,
+	MLX_FILTER_LINEAR = 1
+} mlx_filter;
+
+typedef enum
+{
+	MLX_FLIP_NONE = 0,
+	MLX_FLIP_X = 1,
+	MLX_FLIP_Y = 2
+} mlx_flip;
+
 
 /**
  * @brief			Initializes the MLX internal application
@@ -169,6 +189,190 @@ MLX_API int mlx_on_event(void* mlx, void* win, mlx_event_type event, int (*f)(in
 MLX_API int mlx_pixel_put(void* mlx, void* win, int x, int y, int color);
 
 
+/**
+ * @brief			Moves all the pixels put in the window, like a terminal scrolling its lines
+ *
+ * @param mlx		Internal MLX application
+ * @param win		Internal window
+ * @param dx		Horizontal shift in pixels, positive to move them right
+ * @param dy		Vertical shift in pixels, positive to move them down
+ * @param fill_color	Color of the exposed pixels (coded on 4 bytes in an int, 0xAARRGGBB)
+ *
+ * @note			Only pixels put with mlx_pixel_put are moved, not images nor texts
+ * @note			The shift is done by the GPU, only the exposed pixels are uploaded
+ *
+ * @return (int)	Always return 0
+ */
+MLX_API int mlx_scroll_window_pixels(void* mlx, void* win, int dx, int dy, int fill_color);
+
+
+/**
+ * @brief			Draws a line in the window
+ *
+ * @param mlx		Internal MLX application
+ * @param win		Internal window
+ * @param x0		X coordinate of the first end
+ * @param y0		Y coordinate of the first end
+ * @param x1		X coordinate of the second end
+ * @param y1		Y coordinate of the second end
+ * @param thickness	Width of the line in pixels, at least 1
+ * @param color		Color of the line (coded on 4 bytes in an int, 0xAARRGGBB)
+ *
+ * @note			Shapes are drawn by the GPU without touching the pixels put with mlx_pixel_put, they stay
+ * 					in the window until the next mlx_clear_window like images and texts
+ * @note			Shapes put one after the other are drawn in a single call, put images and texts
+ * 					before or after them to keep the batches long
+ *
+ * @return (int)	Always return 0
+ */
+MLX_API int mlx_draw_line(void* mlx, void* win, int x0, int y0, int x1, int y1, int thickness, int color);
+
+
+/**
+ * @brief			Draws the outline of a rectangle in the window
+ *
+ * @param mlx		Internal MLX application
+ * @param win		Internal window
+ * @param x			X coordinate of the top left corner
+ * @param y			Y coordinate of the top left corner
+ * @param width		Width of the rectangle
+ * @param height	Height of the rectangle
+ * @param thickness	Width of the outline in pixels, drawn inside the rectangle
+ * @param color		Color of the outline (coded on 4 bytes in an int, 0xAARRGGBB)
+ *
+ * @return (int)	Always return 0
+ */
+MLX_API int mlx_draw_rect(void* mlx, void* win, int x, int y, int width, int height, int thickness, int color);
+
+
+/**
+ * @brief			Fills a rectangle in the window
+ *
+ * @param mlx		Internal MLX application
+ * @param win		Internal window
+ * @param x			X coordinate of the top left corner
+ * @param y			Y coordinate of the top left corner
+ * @param width		Width of the rectangle
+ * @param height	Height of the rectangle
+ * @param color		Color of the rectangle (coded on 4 bytes in an int, 0xAARRGGBB)
+ *
+ * @return (int)	Always return 0
+ */
+MLX_API int mlx_fill_rect(void* mlx, void* win, int x, int y, int width, int height, int color);
+
+
+/**
+ * @brief			Draws the outline of a circle in the window
+ *
+ * @param mlx		Internal MLX application
+ * @param win		Internal window
+ * @param x			X coordinate of the center
+ * @param y			Y coordinate of the center
+ * @param radius	Radius of the circle
+ * @param thickness	Width of the outline in pixels, centered on the radius
+ * @param color		Color of the outline (coded on 4 bytes in an int, 0xAARRGGBB)
+ *
+ * @return (int)	Always return 0
+ */
+MLX_API int mlx_draw_circle(void* mlx, void* win, int x, int y, int radius, int thickness, int color);
+
+
+/**
+ * @brief			Fills a circle in the window
+ *
+ * @param mlx		Internal MLX application
+ * @param win		Internal window
+ * @param x			X coordinate of the center
+ * @param y			Y coordinate of the center
+ * @param radius	Radius of the circle
+ * @param color		Color of the circle (coded on 4 bytes in an int, 0xAARRGGBB)
+ *
+ * @return (int)	Always return 0
+ */
+MLX_API int mlx_fill_circle(void* mlx, void* win, int x, int y, int radius, int color);
+
+
+/**
+ * @brief			Fills a polygon in the window
+ *
+ * @param mlx		Internal MLX application
+ * @param win		Internal window
+ * @param points	Coordinates of the corners as x, y pairs
+ * @param count		Number of corners, at least 3
+ * @param color		Color of the polygon (coded on 4 bytes in an int, 0xAARRGGBB)
+ *
+ * @note			Concave polygons are supported in any winding, self intersecting ones are not
+ *
+ * @return (int)	Always return 0
+ */
+MLX_API int mlx_fill_polygon(void* mlx, void* win, const int* points, int count, int color);
+
+
+/**
+ * @brief			Creates a pixel layer, a window sized set of pixels drawn apart from the window ones
+ *
+ * @param mlx		Internal MLX application
+ * @param win		Internal window
+ * @param z			Depth of the layer, negative layers are drawn under the images and texts,
+ * 					the others over the window pixels. Layers of the same depth are drawn in creation order
+ *
+ * @note			A layer is only uploaded when its own pixels change, a static background drawn in a layer
+ * 					is not uploaded again when the pixels of an overlay change
+ * @note			Layers are not cleared by mlx_clear_window and are destroyed with their window
+ *
+ * @return (void*)	An opaque pointer to the internal pixel layer or NULL (0x0) in case of error
+ */
+MLX_API void* mlx_new_pixel_layer(void* mlx, void* win, int z);
+
+
+/**
+ * @brief			Put a pixel in a pixel layer
+ *
+ * @param mlx		Internal MLX application
+ * @param layer		Internal pixel layer
+ * @param x			X coordinate
+ * @param y			Y coordinate
+ * @param color		Color of the pixel (coded on 4 bytes in an int, 0xAARRGGBB)
+ *
+ * @return (int)	Always return 0
+ */
+MLX_API int mlx_layer_pixel_put(void* mlx, void* layer, int x, int y, int color);
+
+
+/**
+ * @brief			Clears a pixel layer
+ *
+ * @param mlx		Internal MLX application
+ * @param layer		Internal pixel layer
+ *
+ * @return (int)	Always return 0
+ */
+MLX_API int mlx_clear_pixel_layer(void* mlx, void* layer);
+
+
+/**
+ * @brief			Changes the depth of a pixel layer
+ *
+ * @param mlx		Internal MLX application
+ * @param layer		Internal pixel layer
+ * @param z			New depth, the layer is drawn after the other layers of this depth
+ *
+ * @return (int)	Always return 0
+ */
+MLX_API int mlx_set_pixel_layer_depth(void* mlx, void* layer, int z);
+
+
+/**
+ * @brief			Destroys a pixel layer
+ *
+ * @param mlx		Internal MLX application
+ * @param layer		Internal pixel layer
+ *
+ * @return (int)	Always return 0
+ */
+MLX_API int mlx_destroy_pixel_layer(void* mlx, void* layer);
+
+
 /**
  * @brief			Create a new empty image
  *
@@ -238,6 +442,64 @@ MLX_API void mlx_set_image_pixel(void* mlx, void* img, int x, int y, int color);
 MLX_API int mlx_put_image_to_window(void* mlx, void* win, void* img, int x, int y);
 
 
+/**
+ * @brief			Put a part of an image to the given window, like a frame of a sprite sheet
+ *
+ * @param mlx		Internal MLX application
+ * @param win		Internal window
+ * @param img		Internal image
+ * @param src_x		X coordinate of the part in the image
+ * @param src_y		Y coordinate of the part in the image
+ * @param src_w		Width of the part
+ * @param src_h		Height of the part
+ * @param dst_x		X coordinate in the window
+ * @param dst_y		Y coordinate in the window
+ *
+ * @note			The part is drawn straight from the image, no pixel is copied. It is clipped to the image
+ *
+ * @return (int)	Always return 0
+ */
+MLX_API int mlx_put_image_region_to_window(void* mlx, void* win, void* img, int src_x, int src_y, int src_w, int src_h, int dst_x, int dst_y);
+
+
+/**
+ * @brief			Put an image to the given window scaled, rotated, flipped and tinted
+ *
+ * @param mlx		Internal MLX application
+ * @param win		Internal window
+ * @param img		Internal image
+ * @param x			X coordinate in the window where the pivot is drawn
+ * @param y			Y coordinate in the window where the pivot is drawn
+ * @param scale_x	Horizontal scale factor
+ * @param scale_y	Vertical scale factor
+ * @param angle		Rotation around the pivot in degrees, clockwise
+ * @param pivot_x	X coordinate of the pivot in the image
+ * @param pivot_y	Y coordinate of the pivot in the image
+ * @param flip		Combination of mlx_flip flags, the image is mirrored in place
+ * @param tint		Color multiplied with the image pixels (0xAARRGGBB), 0xFFFFFFFF keeps the image as is
+ *
+ * @note			The transformation is done by the GPU while drawing, no pixel is copied
+ * @note			Scaled images are sampled with the filter set by mlx_set_image_filter
+ *
+ * @return (int)	Always return 0
+ */
+MLX_API int mlx_put_image_transformed(void* mlx, void* win, void* img, int x, int y, float scale_x, float scale_y, float angle, int pivot_x, int pivot_y, int flip, int tint);
+
+
+/**
+ * @brief			Sets how an image is sampled when drawn scaled or rotated
+ *
+ * @param mlx		Internal MLX application
+ * @param img		Internal image
+ * @param filter	MLX_FILTER_NEAREST to keep sharp pixels (default) or MLX_FILTER_LINEAR to smooth them
+ *
+ * @note			Linear filtered images are clamped to their edges instead of repeated
+ *
+ * @return (int)	Always return 0
+ */
+MLX_API int mlx_set_image_filter(void* mlx, void* img, mlx_filter filter);
+
+
 /**
  * @brief			Destroys internal image
  *
@@ -288,6 +550,258 @@ MLX_API void* mlx_jpg_file_to_image(void* mlx, char* filename, int* width, int*
 MLX_API void* mlx_bmp_file_to_image(void* mlx, char* filename, int* width, int* height);
 
 
+/**
+ * @brief			Create a new image from a png file already loaded in memory
+ *
+ * @param mlx		Internal MLX application
+ * @param data		Content of the png file
+ * @param size		Size of the content in bytes
+ * @param width		Get the width of the image
+ * @param heigth	Get the height of the image
+ *
+ * @return (void*)	An opaque pointer to the internal image or NULL (0x0) in case of error
+ */
+MLX_API void* mlx_png_memory_to_image(void* mlx, const void* data, int size, int* width, int* height);
+
+
+/**
+ * @brief			Create a new image from a jpg file already loaded in memory
+ *
+ * @param mlx		Internal MLX application
+ * @param data		Content of the jpg file
+ * @param size		Size of the content in bytes
+ * @param width		Get the width of the image
+ * @param heigth	Get the height of the image
+ *
+ * @return (void*)	An opaque pointer to the internal image or NULL (0x0) in case of error
+ */
+MLX_API void* mlx_jpg_memory_to_image(void* mlx, const void* data, int size, int* width, int* height);
+
+
+/**
+ * @brief			Create a new image from a bmp file already loaded in memory
+ *
+ * @param mlx		Internal MLX application
+ * @param data		Content of the bmp file
+ * @param size		Size of the content in bytes
+ * @param width		Get the width of the image
+ * @param heigth	Get the height of the image
+ *
+ * @return (void*)	An opaque pointer to the internal image or NULL (0x0) in case of error
+ */
+MLX_API void* mlx_bmp_memory_to_image(void* mlx, const void* data, int size, int* width, int* height);
+
+
+/**
+ * @brief			Create a new image from an image file already loaded in memory,
+ *					the format (png, jpg, bmp, tga, ...) is guessed from its content
+ *
+ * @param mlx		Internal MLX application
+ * @param data		Content of the image file
+ * @param size		Size of the content in bytes
+ * @param width		Get the width of the image
+ * @param heigth	Get the height of the image
+ *
+ * @return (void*)	An opaque pointer to the internal image or NULL (0x0) in case of error
+ */
+MLX_API void* mlx_memory_to_image(void* mlx, const void* data, int size, int* width, int* height);
+
+
+/**
+ * @brief			Loads several images in the background
+ *
+ * @param mlx		Internal MLX application
+ * @param paths		Paths to the image files (png, jpg, bmp, ...)
+ * @param count		Number of paths
+ * @param images	Array of `count` pointers filled right away with the internal images, NULL for the files that cannot be read
+ * @param on_loaded	Function called for each image once it is ready with the image, its index in `paths` and
+ * 					its size, can be NULL. The image is NULL if it could not be loaded, the handle is then invalid
+ * @param param		Param given to the function
+ *
+ * @note			Images are decoded by the MLX worker threads and uploaded in batches during `mlx_loop`,
+ * 					before the loop hook, where `on_loaded` is called
+ * @note			Putting an image that is not ready yet does nothing, use `mlx_image_is_ready` to know when it is.
+ * 					It can be destroyed at any time
+ *
+ * @return (int)	Always return 0
+ */
+MLX_API int mlx_load_images_async(void* mlx, char** paths, int count, void** images, void (*on_loaded)(void* img, int index, int width, int height, void* param), void* param);
+
+
+/**
+ * @brief			Tells if an image loaded with `mlx_load_images_async` is ready to be used
+ *
+ * @param mlx		Internal MLX application
+ * @param img		Internal image
+ *
+ * @return (int)	1 if the image is ready, 0 otherwise
+ */
+MLX_API int mlx_image_is_ready(void* mlx, void* img);
+
+
+/**
+ * @brief			Enables or disables the image cache (disabled by default)
+ *
+ * @param mlx		Internal MLX application
+ * @param enable	Enable or disable the cache
+ *
+ * @note			When enabled, loading the same file (same path and modification time) or the same
+ * 					memory buffer again does not decode nor upload it, the images share the same GPU memory.
+ * 					Each image is still a distinct handle that must be destroyed with `mlx_destroy_image`
+ * @note			Modifying a shared image (`mlx_set_image_pixel`, `mlx_parallel_for_tiles`, rendering in it)
+ * 					gives it its own copy first, the other images are not affected
+ *
+ * @return (int)	Always return 0
+ */
+MLX_API int mlx_set_image_cache(void* mlx, int enable);
+
+
+/**
+ * @brief			Creates a tilemap, a grid of tiles taken from a tileset image and drawn in one go
+ *
+ * @param mlx		Internal MLX application
+ * @param tileset	Internal image holding the tiles, left to right then top to bottom
+ * @param tile_w	Width of a tile in pixels
+ * @param tile_h	Height of a tile in pixels
+ * @param cols		Number of columns of the grid (4096 max)
+ * @param rows		Number of rows of the grid (4096 max)
+ *
+ * @note			All the cells start empty. The grid lives on the GPU, setting a cell only uploads that cell
+ * @note			The tileset must not be destroyed before the tilemap, the tilemap draws nothing once it is
+ *
+ * @return (void*)	An opaque pointer to the tilemap or NULL (0x0) in case of error
+ */
+MLX_API void* mlx_new_tilemap(void* mlx, void* tileset, int tile_w, int tile_h, int cols, int rows);
+
+
+/**
+ * @brief			Sets the tile of a cell of a tilemap
+ *
+ * @param mlx		Internal MLX application
+ * @param map		Internal tilemap
+ * @param col		Column of the cell
+ * @param row		Row of the cell
+ * @param tile		Index of the tile in the tileset or -1 to empty the cell
+ *
+ * @return (int)	Always return 0
+ */
+MLX_API int mlx_set_tile(void* mlx, void* map, int col, int row, int tile);
+
+
+/**
+ * @brief			Scrolls the content of a tilemap
+ *
+ * @param mlx		Internal MLX application
+ * @param map		Internal tilemap
+ * @param x			Position in pixels of the grid shown at the top left corner of the drawn area
+ * @param y			Position in pixels of the grid shown at the top left corner of the drawn area
+ *
+ * @return (int)	Always return 0
+ */
+MLX_API int mlx_set_tilemap_scroll(void* mlx, void* map, int x, int y);
+
+
+/**
+ * @brief			Puts a tilemap to the given window
+ *
+ * @param mlx		Internal MLX application
+ * @param win		Internal window
+ * @param map		Internal tilemap
+ * @param x			X coordinate of the drawn area in the window
+ * @param y			Y coordinate of the drawn area in the window
+ * @param w			Width of the drawn area
+ * @param h			Height of the drawn area
+ *
+ * @note			Empty cells and what is outside of the grid are left transparent
+ *
+ * @return (int)	Always return 0
+ */
+MLX_API int mlx_put_tilemap_to_window(void* mlx, void* win, void* map, int x, int y, int w, int h);
+
+
+/**
+ * @brief			Destroys a tilemap, its tileset is not destroyed
+ *
+ * @param mlx		Internal MLX application
+ * @param map		Internal tilemap
+ *
+ * @return (int)	Always return 0
+ */
+MLX_API int mlx_destroy_tilemap(void* mlx, void* map);
+
+
+/**
+ * @brief			Opens an asset pack made by the MLX packer (`make packer`)
+ *
+ * @param mlx		Internal MLX application
+ * @param path		Path to the pack file
+ *
+ * @note			The pack holds already decoded images, atlases and fonts, the file is mapped in memory and
+ * 					they are uploaded from it without any decoding
+ *
+ * @return (void*)	An opaque pointer to the pack or NULL (0x0) in case of error
+ */
+MLX_API void* mlx_open_asset_pack(void* mlx, const char* path);
+
+
+/**
+ * @brief			Closes an asset pack, images and fonts created from it stay valid
+ *
+ * @param mlx		Internal MLX application
+ * @param pack		Pack to close
+ *
+ * @return (int)	Always return 0
+ */
+MLX_API int mlx_close_asset_pack(void* mlx, void* pack);
+
+
+/**
+ * @brief			Creates a new image from an image of an asset pack
+ *
+ * @param mlx		Internal MLX application
+ * @param pack		Asset pack
+ * @param name		Name of the image in the pack, the path that was given to the packer
+ * @param width		Get the width of the image
+ * @param heigth	Get the height of the image
+ *
+ * @return (void*)	An opaque pointer to the internal image or NULL (0x0) in case of error
+ */
+MLX_API void* mlx_pack_to_image(void* mlx, void* pack, const char* name, int* width, int* height);
+
+
+/**
+ * @brief			Gets the atlas image holding an image packed in an atlas, and where it is in it
+ *
+ * @param mlx		Internal MLX application
+ * @param pack		Asset pack
+ * @param name		Name of the image in the pack, the path that was given to the packer
+ * @param x			Get the position of the image in the atlas
+ * @param y			Get the position of the image in the atlas
+ * @param width		Get the width of the image
+ * @param heigth	Get the height of the image
+ *
+ * @note			The atlas image is created on first use and shared by all its images until it is destroyed
+ *
+ * @return (void*)	An opaque pointer to the internal atlas image or NULL (0x0) in case of error
+ */
+MLX_API void* mlx_pack_region_to_image(void* mlx, void* pack, const char* name, int* x, int* y, int* width, int* height);
+
+
+/**
+ * @brief			Sets the font of a window to a font baked in an asset pack
+ *
+ * @param mlx		Internal MLX application
+ * @param win		Internal window
+ * @param pack		Asset pack
+ * @param name		Name of the font in the pack, the path that was given to the packer
+ *
+ * @note			Must be called from the thread that called `mlx_init`
+ *
+ * @return (int)	Always return 0
+ */
+MLX_API int mlx_set_font_from_pack(void* mlx, void* win, void* pack, const char* name);
+
+
 /**
  * @brief			Put text in given window
  *
@@ -382,6 +896,213 @@ MLX_API int mlx_get_screens_size(void* mlx, void* win, int* w, int* h);
  */
 MLX_API int mlx_set_fps_goal(void* mlx, int fps);
 
+
+/**
+ * @brief			Sets how many frames can be processed by the GPU at the same time for windows created after this call
+ *
+ * @param mlx		Internal MLX application
+ * @param count		Number of frames in flight, between 1 and 8 (3 by default).
+ * 					Lower counts reduce input latency, higher counts help throughput bound rendering
+ *
+ * @note			Call it right after `mlx_init` to set it for the whole application,
+ * 					or before each `mlx_new_window` to choose it per window
+ *
+ * @return (int)	Always return 0
+ */
+MLX_API int mlx_set_frames_in_flight(void* mlx, int count);
+
+
+/**
+ * @brief					Only renders windows when their content changed instead of every loop turn
+ *
+ * @param mlx				Internal MLX application
+ * @param enable			1 to enable on demand rendering, 0 to go back to continuous rendering (default)
+ * @param idle_timeout_ms	Maximum time in milliseconds the loop sleeps waiting for an event when nothing
+ * 							has to be redrawn. The loop hook is still called at least once per timeout
+ *
+ * @note					Windows are redrawn when a put/clear/destroy call changes what they show,
+ * 							when an image they display is modified or when they receive a window event
+ *
+ * @return (int)			Always return 0
+ */
+MLX_API int mlx_set_render_on_demand(void* mlx, int enable, int idle_timeout_ms);
+
+
+/**
+ * @brief			Renders the windows on a dedicated thread so the next frame logic runs while the previous one is rendered
+ *
+ * @param mlx		Internal MLX application
+ * @param enable	1 to start the render thread, 0 to go back to rendering in `mlx_loop` (default)
+ *
+ * @note			Puts, clears and font loads are recorded and replayed on the render thread at the end of the frame.
+ * 					Creating or destroying windows and images and modifying image pixels wait for the frame being rendered
+ * 					to be done, modify your images before putting anything in the frame to keep the most overlap
+ * @note			All MLX functions must still be called from the thread that called `mlx_init`
+ *
+ * @return (int)	Always return 0
+ */
+MLX_API int mlx_set_render_thread(void* mlx, int enable);
+
+
+/**
+ * @brief			Sets the ordering key of the puts issued by the calling thread
+ *
+ * @param mlx		Internal MLX application
+ * @param key		Ordering key, 0 by default
+ *
+ * @note			`mlx_pixel_put`, `mlx_string_put`, `mlx_put_image_to_window`, the shapes drawing functions and
+ * 					`mlx_clear_window` can be called from any thread. Puts issued outside of the thread that called `mlx_init` are queued per thread and
+ * 					merged at the end of the loop turn, after the main thread ones, sorted by key, then by the order in
+ * 					which the threads first issued a put, then by call order. Give each thread its own key to get the
+ * 					same frame from one run to another
+ * @note			Worker threads must be done putting before the loop hook returns to be part of the frame.
+ * 					Windows and images may be created or destroyed meanwhile, the puts of a destroyed one are dropped
+ *
+ * @return (int)	Always return 0
+ */
+MLX_API int mlx_set_thread_order_key(void* mlx, int key);
+
+
+/**
+ * @brief				Computes every pixel of a window or an image in parallel, tile by tile
+ *
+ * @param mlx			Internal MLX application
+ * @param win_or_img	Internal window or internal image
+ * @param tile_w		Width of the tiles the work is split in
+ * @param tile_h		Height of the tiles the work is split in
+ * @param f				Function called for each pixel with its coordinates and `param`, returns the pixel color
+ * 						in 0xAARRGGBB. It is called from several threads at once and must not call MLX functions
+ * @param param			Param given to the function
+ *
+ * @note				Runs on the MLX job system, with one thread per core. Writes the pixels
+ * 						directly, on a window it is the same as calling `mlx_pixel_put` on every pixel
+ * @note				Returns once every pixel has been computed
+ *
+ * @return (int)		Always return 0
+ */
+MLX_API int mlx_parallel_for_tiles(void* mlx, void* win_or_img, int tile_w, int tile_h, int (*f)(int x, int y, void* param), void* param);
+
+
+/**
+ * @brief			Runs a function on the MLX worker threads
+ *
+ * @param mlx		Internal MLX application
+ * @param job		Function to run, it is called from another thread and must not call MLX functions
+ * 					other than the ones allowed from other threads
+ * @param on_done	Function called on the thread that called `mlx_init` once the job is done, can be NULL.
+ * 					It is called during `mlx_loop` before the loop hook, or by `mlx_job_wait` when it is
+ * 					called from that thread
+ * @param param		Param given to both functions
+ *
+ * @note			The workers are shared with the MLX internal tasks like image decoding or font baking
+ *
+ * @note			A job is released once it and its `on_done` callback are done, waiting for it is not required
+ *
+ * @return (void*)	An opaque pointer to the job, to give to `mlx_job_wait`, or NULL on error
+ */
+MLX_API void* mlx_job_submit(void* mlx, void (*job)(void* param), void (*on_done)(void* param), void* param);
+
+
+/**
+ * @brief			Waits for a job and its `on_done` callback to be done
+ *
+ * @param mlx		Internal MLX application
+ * @param job		Job returned by `mlx_job_submit`, returns right away if it is already done
+ *
+ * @note			The calling thread runs other jobs while waiting
+ *
+ * @return (int)	Always return 0
+ */
+MLX_API int mlx_job_wait(void* mlx, void* job);
+
+
+/**
+ * @brief			Chooses how the given window presents its frames
+ *
+ * @param mlx		Internal MLX application
+ * @param win		Internal window
+ * @param mode		`MLX_PRESENT_IMMEDIATE` (default, no vsync, may tear), `MLX_PRESENT_MAILBOX` (no tearing, no vsync wait)
+ * 					or `MLX_PRESENT_FIFO` (vsync). If the mode is not supported by the system another one is picked
+ *
+ * @return (int)	Always return 0
+ */
+MLX_API int mlx_set_window_present_mode(void* mlx, void* win, mlx_present_mode mode);
+
+
+/**
+ * @brief			Only redraws the parts of the window that changed since the previous frame
+ *
+ * @param mlx		Internal MLX application
+ * @param win		Internal window
+ * @param enable	1 to enable damage tracking, 0 to disable it (default)
+ *
+ * @note			Useful when only a few images move on a busy window. The window content is kept in
+ * 					an offscreen image so it costs an extra copy per frame and some memory
+ * @note			No frame is presented as long as nothing changed on the window
+ *
+ * @return (int)	Always return 0
+ */
+MLX_API int mlx_set_window_damage_tracking(void* mlx, void* win, int enable);
+
+
+/**
+ * @brief			Sets the part of the world shown by a window, like a camera
+ *
+ * @param mlx		Internal MLX application
+ * @param win		Internal window
+ * @param offset_x	X coordinate of the world shown at the top left corner of the window
+ * @param offset_y	Y coordinate of the world shown at the top left corner of the window
+ * @param zoom		Size of a world pixel on the window, 1.0 by default
+ *
+ * @note			Images, tilemaps and texts are put in world coordinates, moving the view does not
+ * 					require putting them again at new coordinates. Pixels put with mlx_pixel_put stay
+ * 					in window coordinates
+ * @note			The view applies to the whole frame it is set in
+ *
+ * @return (int)	Always return 0
+ */
+MLX_API int mlx_set_window_view(void* mlx, void* win, int offset_x, int offset_y, float zoom);
+
+
+/**
+ * @brief			Gets statistics about the frame times achieved over the last 128 frames
+ *
+ * @param mlx		Internal MLX application
+ * @param mean		Get the mean frame time in milliseconds (can be NULL)
+ * @param variance	Get the frame time variance in squared milliseconds (can be NULL)
+ *
+ * @return (int)	Always return 0
+ */
+MLX_API int mlx_get_frame_time_stats(void* mlx, float* mean, float* variance);
+
+
+/**
+ * @brief			Starts recording every frame presented by the given window
+ *
+ * @param mlx		Internal MLX application
+ * @param win		Internal window (a window targeting an image is recorded the same way)
+ * @param filepath	Path of the output file, a `.y4m` extension records a YUV4MPEG2 video,
+ * 					any other extension records raw RGBA frames one after the other
+ * @param fps		Framerate written in the video header
+ *
+ * @note			Frames are read back and written to disk on a separate thread,
+ * 					if the disk cannot keep up frames are dropped instead of slowing down the rendering
+ *
+ * @return (int)	Always return 0
+ */
+MLX_API int mlx_start_recording(void* mlx, void* win, const char* filepath, int fps);
+
+
+/**
+ * @brief			Stops the recording of the given window and flushes the output file
+ *
+ * @param mlx		Internal MLX application
+ * @param win		Internal window
+ *
+ * @return (int)	Always return 0
+ */
+MLX_API int mlx_stop_recording(void* mlx, void* win);
+
 #ifdef __cplusplus
 }
 #endif
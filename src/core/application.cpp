@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/10/04 22:10:52 by maldavid          #+#    #+#             */
-/*   Updated: 2024/10/19 10:49:21 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 04:39:21 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -19,13 +19,24 @@
 #include <core/errors.h>
 #include <mlx_profile.h>
 #include <core/memory.h>
+#include <renderer/buffers/vk_buffer.h>
 
 namespace mlx::core
 {
+	constexpr const std::size_t UPLOAD_BATCH_BUDGET = 64 * 1024 * 1024; // bytes uploaded per loop turn, and staging memory of the running decodes, when loading images asynchronously
+
 	static bool __drop_sdl_responsability = false;
-	Application::Application() : _fps(), _in(std::make_unique<Input>()) 
+	Application::Application() : _fps(), _main_thread(std::this_thread::get_id()), _in(std::make_unique<Input>()) 
 	{
 		_fps.init();
+		JobSystem::get().init();
+		// wakes the loop up when it sleeps waiting for events so the completed jobs are handled right away
+		JobSystem::get().setMainThreadNotifier([]()
+		{
+			SDL_Event event{};
+			event.type = SDL_USEREVENT;
+			SDL_PushEvent(&event);
+		});
 		__drop_sdl_responsability = SDL_WasInit(SDL_INIT_VIDEO);
 		if(__drop_sdl_responsability) // is case the mlx is running in a sandbox like MacroUnitTester where SDL is already init
 			return;
@@ -41,36 +52,138 @@ namespace mlx::core
 	void Application::run() noexcept
 	{
 		_in->run();
+		_fps.init();
 		while(_in->isRunning())
 		{
-			if(!_fps.update())
-				continue;
+			_fps.update();
 			_in->update();
 
+			for(auto& gs : _graphics)
+			{
+				if(!gs || !gs->hasWindow() || !_in->hasWindowEvent(gs->getWindow()->getID()))
+					continue;
+				// exposed, resized, restored, ... the window content may have been lost
+				int width, height;
+				gs->getWindow()->getDrawableSize(width, height); // the swapchain may be recreated on the render thread, where SDL cannot be queried
+				VkExtent2D size = { static_cast<std::uint32_t>(width), static_cast<std::uint32_t>(height) };
+				if(_render_thread.isRunning())
+				{
+					RenderCommand command = makeCommand(RenderCommand::kind::set_drawable_size, &gs->getID());
+					command.region.extent = size;
+					recordCommand(command);
+					recordCommand(makeCommand(RenderCommand::kind::require_redraw, &gs->getID()));
+				}
+				else
+				{
+					gs->getRenderer().setDrawableSize(size);
+					gs->requireRedraw();
+				}
+			}
+
+			// completion callbacks of the jobs that finished since the last turn
+			JobSystem::get().pumpMainThreadJobs();
+			uploadLoadedImages();
+
 			if(_loop_hook)
 				_loop_hook(_param);
 
-			for(auto& gs : _graphics)
+			// puts issued by other threads during the frame, after the main thread ones
+			if(_render_thread.isRunning())
+				_put_queues.merge(_render_thread.getRecordingPacket());
+			else
 			{
-				if(gs)
-					gs->render();
+				_put_queues.merge(_queued_puts);
+				replayFramePacket(_queued_puts);
+				_queued_puts.clear();
 			}
+
+			// with a render thread the frame recorded by the loop hook is rendered while the next one is being recorded
+			bool rendered = (_render_thread.isRunning() ? _render_thread.submitFrame() : renderFrame());
+
+			// nothing changed, sleep until the user does something instead of spinning
+			if(_render_on_demand && !rendered)
+				_in->waitEvent(_idle_timeout);
 		}
 
+		syncRenderThread();
 		Render_Core::get().getSingleTimeCmdManager().updateSingleTimesCmdBuffersSubmitState();
 
 		for(auto& gs : _graphics)
 		{
 			if(!gs)
 				continue;
-			for(int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+			for(std::uint32_t i = 0; i < gs->getRenderer().getFramesInFlight(); i++)
 				gs->getRenderer().getCmdBuffer(i).waitForExecution();
 		}
 	}
 
+	bool Application::renderFrame() noexcept
+	{
+		MLX_PROFILE_FUNCTION();
+		bool rendered = false;
+		for(auto& gs : _graphics)
+		{
+			if(gs)
+				rendered |= gs->render(_render_on_demand);
+		}
+		return rendered;
+	}
+
+	void Application::replayFramePacket(FramePacket& packet)
+	{
+		MLX_PROFILE_FUNCTION();
+		for(const RenderCommand& command : packet.commands)
+		{
+			auto& gs = _graphics[command.window];
+			if(!gs) // window destroyed after the command has been recorded
+				continue;
+			switch(command.type)
+			{
+				case RenderCommand::kind::pixel_put: gs->pixelPut(command.x, command.y, command.color); break;
+				case RenderCommand::kind::scroll_pixels: gs->scrollPixels(command.x, command.y, command.color); break;
+				case RenderCommand::kind::layer_pixel_put: gs->layerPixelPut(command.layer, command.x, command.y, command.color); break;
+				case RenderCommand::kind::layer_clear: gs->clearPixelLayer(command.layer); break;
+				case RenderCommand::kind::string_put: gs->stringPut(command.x, command.y, command.color, packet.strings[command.string]); break;
+				case RenderCommand::kind::texture_put: gs->texturePut(command.texture, command.x, command.y, command.region, command.transform != RenderCommand::NO_TRANSFORM ? packet.transforms[command.transform] : ImageTransform{}); break;
+				case RenderCommand::kind::tilemap_put: gs->tilemapPut(command.tilemap, command.x, command.y, command.region.extent.width, command.region.extent.height); break;
+				case RenderCommand::kind::shape_put: gs->shapePut(packet.vertices.data() + command.vertices, command.region.extent.width); break;
+				case RenderCommand::kind::clear: gs->clearRenderData(); break;
+				case RenderCommand::kind::load_font: gs->loadFont(packet.strings[command.string], command.scale); break;
+				case RenderCommand::kind::require_redraw: gs->requireRedraw(); break;
+				case RenderCommand::kind::set_view: gs->setView(command.x, command.y, command.scale); break;
+				case RenderCommand::kind::set_drawable_size: gs->getRenderer().setDrawableSize(command.region.extent); break;
+
+				default: break;
+			}
+		}
+	}
+
+	void Application::setRenderThread(bool enable)
+	{
+		MLX_PROFILE_FUNCTION();
+		if(enable == _render_thread.isRunning())
+			return;
+		if(enable)
+		{
+			_render_thread.start([this](FramePacket& packet)
+			{
+				replayFramePacket(packet);
+				return renderFrame();
+			});
+			return;
+		}
+		_render_thread.sync();
+		_render_thread.stop();
+		// what has been recorded since the last frame has not been handed over yet, it is applied right away
+		replayFramePacket(_render_thread.getRecordingPacket());
+		_render_thread.getRecordingPacket().clear();
+	}
+
 	void* Application::newTexture(int w, int h)
 	{
 		MLX_PROFILE_FUNCTION();
+		syncRenderThread();
+		std::unique_lock<std::shared_mutex> lock(_resources_mutex);
 		#ifdef DEBUG
 			_textures.emplace_front().create(nullptr, w, h, VK_FORMAT_R8G8B8A8_UNORM, "__mlx_unamed_user_texture");
 		#else
@@ -82,13 +195,341 @@ namespace mlx::core
 	void* Application::newStbTexture(char* file, int* w, int* h)
 	{
 		MLX_PROFILE_FUNCTION();
-		_textures.emplace_front(stbTextureLoad(file, w, h));
+		syncRenderThread();
+		if(_image_cache.isEnabled())
+		{
+			std::string key = ImageCache::fileKey(file);
+			if(!key.empty())
+				return newCachedTexture(key, [&]() { return stbTextureLoad(file, nullptr, nullptr, &_image_atlas); }, w, h);
+		}
+		Texture texture = stbTextureLoad(file, w, h, &_image_atlas);
+		std::unique_lock<std::shared_mutex> lock(_resources_mutex);
+		_textures.emplace_front(std::move(texture));
+		return &_textures.front();
+	}
+
+	void* Application::newStbTextureFromMemory(const std::uint8_t* data, std::size_t size, int* w, int* h)
+	{
+		MLX_PROFILE_FUNCTION();
+		int width;
+		int height;
+		if(!stbImageSizeFromMemory(data, size, &width, &height))
+			return nullptr;
+		if(w != nullptr)
+			*w = width;
+		if(h != nullptr)
+			*h = height;
+		syncRenderThread();
+		if(_image_cache.isEnabled())
+			return newCachedTexture(_image_cache.memoryKey(data, size), [&]() { return stbTextureLoadFromMemory(data, size, width, height, &_image_atlas); }, w, h, data, size);
+		Texture texture = stbTextureLoadFromMemory(data, size, width, height, &_image_atlas);
+		std::unique_lock<std::shared_mutex> lock(_resources_mutex);
+		_textures.emplace_front(std::move(texture));
+		return &_textures.front();
+	}
+
+	void* Application::newCachedTexture(const std::string& key, const std::function<Texture()>& load, int* w, int* h, const std::uint8_t* content, std::size_t content_size)
+	{
+		MLX_PROFILE_FUNCTION();
+		Texture* shared = _image_cache.find(key);
+		if(shared == nullptr)
+			shared = &_image_cache.insert(key, load(), content, content_size);
+		std::unique_lock<std::shared_mutex> lock(_resources_mutex);
+		Texture& alias = _textures.emplace_front();
+		alias.createAlias(*shared);
+		_image_cache.addAlias(key, &alias);
+		if(w != nullptr)
+			*w = shared->getWidth();
+		if(h != nullptr)
+			*h = shared->getHeight();
+		return &alias;
+	}
+
+	void Application::detachTexture(Texture* texture)
+	{
+		if(!texture->sharesImage())
+			return;
+		syncRenderThread();
+		std::unique_lock<std::shared_mutex> lock(_resources_mutex);
+		texture->detach();
+		_image_cache.release(texture);
+	}
+
+	void Application::loadImagesAsync(char** paths, int count, void** images, void (*on_loaded)(void*, int, int, int, void*), void* param)
+	{
+		MLX_PROFILE_FUNCTION();
+		for(int i = 0; i < count; i++)
+		{
+			int width;
+			int height;
+			images[i] = nullptr;
+			if(paths[i] == nullptr)
+			{
+				core::error::report(e_kind::error, "invalid image path (NULL) at index %d", i);
+				continue;
+			}
+			if(!stbImageSize(paths[i], &width, &height))
+				continue;
+			std::unique_lock<std::shared_mutex> lock(_resources_mutex);
+			PendingImage& pending = _pending_images.emplace_back();
+			pending.path = paths[i];
+			pending.texture = &_textures.emplace_front();
+			lock.unlock();
+			pending.on_loaded = on_loaded;
+			pending.param = param;
+			pending.width = width;
+			pending.height = height;
+			pending.index = i;
+			images[i] = pending.texture;
+		}
+		std::unique_lock<std::shared_mutex> lock(_resources_mutex);
+		startImageDecodes();
+	}
+
+	void Application::startImageDecodes()
+	{
+		MLX_PROFILE_FUNCTION();
+		// the staging memory is only allocated when a decode starts, so a large set never holds all its pixels at once
+		std::size_t staging_size = 0;
+		for(const PendingImage& pending : _pending_images)
+		{
+			if(pending.decoding.isValid())
+				staging_size += static_cast<std::size_t>(pending.width) * pending.height * 4;
+		}
+		for(auto it = _pending_images.begin(); it != _pending_images.end();)
+		{
+			PendingImage& pending = *it;
+			if(pending.decoding.isValid())
+			{
+				++it;
+				continue;
+			}
+			if(pending.texture == nullptr) // destroyed before its decode started
+			{
+				it = _pending_images.erase(it);
+				continue;
+			}
+			std::size_t size = static_cast<std::size_t>(pending.width) * pending.height * 4;
+			if(staging_size != 0 && staging_size + size > UPLOAD_BATCH_BUDGET) // an image bigger than the budget still gets decoded alone
+				break;
+			staging_size += size;
+			#ifdef DEBUG
+				const char* name = pending.path.c_str();
+			#else
+				const char* name = nullptr;
+			#endif
+			// the workers decode straight in the staging memory, there is no intermediate copy of the pixels
+			void* map = nullptr;
+			pending.staging_buffer = std::make_unique<Buffer>();
+			pending.staging_buffer->create(Buffer::kind::staging, size + DECODE_PADDING, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, name);
+			pending.staging_buffer->mapMem(&map);
+			pending.decoding = JobSystem::get().async([path = pending.path, map, width = pending.width, height = pending.height]()
+			{
+				return stbDecodeImage(path, static_cast<std::uint8_t*>(map), width, height);
+			});
+			JobSystem::get().then(pending.decoding.getJob(), []() {}, true); // wakes the loop up if it is waiting for events
+			++it;
+		}
+	}
+
+	void Application::uploadLoadedImages()
+	{
+		if(_pending_images.empty())
+			return;
+		MLX_PROFILE_FUNCTION();
+		// the images leaving the pending list are created right away, puts from other threads must not see them in between
+		std::unique_lock<std::shared_mutex> lock(_resources_mutex);
+		std::vector<PendingImage> batch;
+		std::size_t staging_size = 0;
+		for(auto it = _pending_images.begin(); it != _pending_images.end() && staging_size < UPLOAD_BATCH_BUDGET;)
+		{
+			if(!it->decoding.isReady())
+			{
+				++it;
+				continue;
+			}
+			if(it->decoding.get() && it->texture != nullptr)
+				staging_size += static_cast<std::size_t>(it->width) * it->height * 4;
+			batch.push_back(std::move(*it));
+			it = _pending_images.erase(it);
+		}
+		if(batch.empty())
+			return;
+
+		syncRenderThread();
+
+		// all the images of the batch are uploaded by a single command buffer
+		CmdBuffer& cmd = Render_Core::get().getSingleTimeCmdBuffer();
+		cmd.beginRecord();
+		for(PendingImage& pending : batch)
+		{
+			if(pending.texture == nullptr || !pending.decoding.get())
+				continue;
+			#ifdef DEBUG
+				const char* name = pending.path.c_str();
+			#else
+				const char* name = nullptr;
+			#endif
+			pending.staging_buffer->flush();
+			pending.texture->create(*pending.staging_buffer, pending.width, pending.height, VK_FORMAT_R8G8B8A8_UNORM, name, cmd, &_image_atlas);
+		}
+		cmd.endRecord();
+		cmd.submitIdle();
+		for(PendingImage& pending : batch)
+		{
+			pending.staging_buffer->destroy();
+			if(pending.texture != nullptr && !pending.decoding.get())
+			{
+				_textures.remove_if([&](const Texture& texture) { return &texture == pending.texture; });
+				pending.texture = nullptr;
+				pending.failed = true;
+			}
+		}
+		startImageDecodes(); // in the staging budget freed by the batch
+		lock.unlock(); // the callbacks may create or destroy images
+
+		for(PendingImage& pending : batch)
+		{
+			if(pending.texture == nullptr && !pending.failed) // destroyed while loading
+				continue;
+			if(pending.on_loaded != nullptr)
+				pending.on_loaded(pending.texture, pending.index, pending.width, pending.height, pending.param);
+		}
+	}
+
+	AssetPack* Application::findAssetPack(void* pack) noexcept
+	{
+		if(pack == nullptr)
+		{
+			core::error::report(e_kind::error, "invalid asset pack ptr (NULL)");
+			return nullptr;
+		}
+		auto it = std::find_if(_asset_packs.begin(), _asset_packs.end(), [=](const AssetPack& asset_pack) { return &asset_pack == pack; });
+		if(it == _asset_packs.end())
+		{
+			core::error::report(e_kind::error, "invalid asset pack ptr");
+			return nullptr;
+		}
+		return &*it;
+	}
+
+	void* Application::openAssetPack(const std::filesystem::path& path)
+	{
+		MLX_PROFILE_FUNCTION();
+		AssetPack& pack = _asset_packs.emplace_front();
+		if(!pack.open(path))
+		{
+			_asset_packs.pop_front();
+			return nullptr;
+		}
+		return &pack;
+	}
+
+	void Application::closeAssetPack(void* pack)
+	{
+		MLX_PROFILE_FUNCTION();
+		AssetPack* asset_pack = findAssetPack(pack);
+		if(asset_pack == nullptr)
+			return;
+		for(auto it = _pack_atlases.begin(); it != _pack_atlases.end();)
+		{
+			if(it->first.first == asset_pack)
+				it = _pack_atlases.erase(it);
+			else
+				++it;
+		}
+		_asset_packs.remove_if([=](const AssetPack& other) { return &other == asset_pack; });
+	}
+
+	void* Application::newPackTexture(AssetPack& pack, const pack::Entry& entry)
+	{
+		syncRenderThread();
+		std::unique_lock<std::shared_mutex> lock(_resources_mutex);
+		#ifdef DEBUG
+			std::string name(pack.getName(entry.name_offset, entry.name_size));
+			_textures.emplace_front().create(const_cast<std::uint8_t*>(pack.getData(entry)), entry.width, entry.height, VK_FORMAT_R8G8B8A8_UNORM, name.c_str());
+		#else
+			_textures.emplace_front().create(const_cast<std::uint8_t*>(pack.getData(entry)), entry.width, entry.height, VK_FORMAT_R8G8B8A8_UNORM, nullptr);
+		#endif
 		return &_textures.front();
 	}
 
+	void* Application::packToTexture(void* pack, const char* name, int* w, int* h)
+	{
+		MLX_PROFILE_FUNCTION();
+		AssetPack* asset_pack = findAssetPack(pack);
+		if(asset_pack == nullptr)
+			return nullptr;
+		const pack::Entry* entry = asset_pack->findEntry(name);
+		if(entry == nullptr || entry->kind != static_cast<std::uint32_t>(pack::EntryKind::image))
+		{
+			core::error::report(e_kind::error, "Asset pack : no image named '%s'", name);
+			return nullptr;
+		}
+		if(w != nullptr)
+			*w = entry->width;
+		if(h != nullptr)
+			*h = entry->height;
+		return newPackTexture(*asset_pack, *entry);
+	}
+
+	void* Application::packRegionToTexture(void* pack, const char* name, int* x, int* y, int* w, int* h)
+	{
+		MLX_PROFILE_FUNCTION();
+		AssetPack* asset_pack = findAssetPack(pack);
+		if(asset_pack == nullptr)
+			return nullptr;
+		const pack::Region* region = asset_pack->findRegion(name);
+		if(region == nullptr)
+		{
+			core::error::report(e_kind::error, "Asset pack : no region named '%s'", name);
+			return nullptr;
+		}
+		if(x != nullptr)
+			*x = region->x;
+		if(y != nullptr)
+			*y = region->y;
+		if(w != nullptr)
+			*w = region->width;
+		if(h != nullptr)
+			*h = region->height;
+		const pack::Entry* atlas = &asset_pack->getEntry(region->entry);
+		auto it = _pack_atlases.find(std::make_pair(asset_pack, atlas));
+		if(it != _pack_atlases.end())
+			return it->second;
+		Texture* texture = static_cast<Texture*>(newPackTexture(*asset_pack, *atlas));
+		_pack_atlases[std::make_pair(asset_pack, atlas)] = texture;
+		return texture;
+	}
+
+	void Application::loadPackFont(void* win, void* pack, const char* name)
+	{
+		MLX_PROFILE_FUNCTION();
+		CHECK_WINDOW_PTR(win);
+		AssetPack* asset_pack = findAssetPack(pack);
+		if(asset_pack == nullptr)
+			return;
+		const pack::Entry* entry = asset_pack->findEntry(name);
+		if(entry == nullptr || entry->kind != static_cast<std::uint32_t>(pack::EntryKind::font))
+		{
+			core::error::report(e_kind::error, "Asset pack : no font named '%s'", name);
+			return;
+		}
+		syncRenderThread();
+		if(_render_thread.isRunning())
+		{
+			// texts recorded earlier in the frame must keep the font they have been put with
+			replayFramePacket(_render_thread.getRecordingPacket());
+			_render_thread.getRecordingPacket().clear();
+		}
+		const stbtt_packedchar* cdata = reinterpret_cast<const stbtt_packedchar*>(asset_pack->getGlyphs(*entry));
+		_graphics[*static_cast<int*>(win)]->loadBakedFont(name, entry->scale, cdata, asset_pack->getData(*entry));
+	}
+
 	void Application::destroyTexture(void* ptr)
 	{
 		MLX_PROFILE_FUNCTION();
+		syncRenderThread();
 		vkDeviceWaitIdle(Render_Core::get().getDevice().get()); // TODO : synchronize with another method than waiting for GPU to be idle
 		if(ptr == nullptr)
 		{
@@ -103,20 +544,325 @@ namespace mlx::core
 			return;
 		}
 		Texture* texture = static_cast<Texture*>(ptr);
+		std::unique_lock<std::shared_mutex> lock(_resources_mutex);
+		auto pending = std::find_if(_pending_images.begin(), _pending_images.end(), [=](const PendingImage& pending) { return pending.texture == texture; });
+		if(pending != _pending_images.end()) // the decoding cannot be stopped, its result will be dropped
+		{
+			pending->texture = nullptr;
+			_textures.erase(it);
+			return;
+		}
 		if(!texture->isInit())
 			core::error::report(e_kind::error, "trying to destroy a texture that has already been destroyed");
 		else
 			texture->destroy();
+		_image_cache.release(texture);
 		for(auto& gs : _graphics)
 		{
 			if(gs)
 				gs->tryEraseTextureFromManager(texture);
 		}
+		for(auto atlas = _pack_atlases.begin(); atlas != _pack_atlases.end();)
+		{
+			if(atlas->second == texture)
+				atlas = _pack_atlases.erase(atlas);
+			else
+				++atlas;
+		}
+		for(Tilemap& tilemap : _tilemaps)
+		{
+			if(tilemap.getTileset() == texture)
+				tilemap.forgetTileset();
+		}
+		// the address could be reused by a new image
+		eraseRecordedCommands([=](const RenderCommand& command)
+		{
+			return command.type == RenderCommand::kind::texture_put && command.texture == texture;
+		});
 		_textures.erase(it);
 	}
 
+	void Application::eraseRecordedCommands(const std::function<bool(const RenderCommand&)>& predicate)
+	{
+		MLX_PROFILE_FUNCTION();
+		_put_queues.eraseCommands(predicate);
+		auto& commands = _render_thread.getRecordingPacket().commands;
+		commands.erase(std::remove_if(commands.begin(), commands.end(), predicate), commands.end());
+	}
+
+	void* Application::newTilemap(void* img, int tile_w, int tile_h, int columns, int rows)
+	{
+		MLX_PROFILE_FUNCTION();
+		CHECK_IMAGE_PTR(img, return nullptr);
+		Texture* tileset = static_cast<Texture*>(img);
+		if(isImageLoading(tileset) || !tileset->isInit())
+		{
+			core::error::report(e_kind::error, "Tilemap : the tileset is still loading or has been destroyed");
+			return nullptr;
+		}
+		if(tile_w <= 0 || tile_h <= 0 || columns <= 0 || rows <= 0)
+		{
+			core::error::report(e_kind::error, "Tilemap : invalid grid of %dx%d tiles of %dx%d pixels", columns, rows, tile_w, tile_h);
+			return nullptr;
+		}
+		if(static_cast<std::uint32_t>(tile_w) > tileset->getWidth() || static_cast<std::uint32_t>(tile_h) > tileset->getHeight())
+		{
+			core::error::report(e_kind::error, "Tilemap : tiles of %dx%d pixels do not fit in a %ux%u tileset", tile_w, tile_h, tileset->getWidth(), tileset->getHeight());
+			return nullptr;
+		}
+		if(static_cast<std::uint32_t>(columns) > Tilemap::MAX_GRID_SIZE || static_cast<std::uint32_t>(rows) > Tilemap::MAX_GRID_SIZE)
+		{
+			core::error::report(e_kind::error, "Tilemap : grids are limited to %u cells per side", Tilemap::MAX_GRID_SIZE);
+			return nullptr;
+		}
+		syncRenderThread();
+		std::unique_lock<std::shared_mutex> lock(_resources_mutex);
+		Tilemap& tilemap = _tilemaps.emplace_front();
+		tilemap.create(tileset, tile_w, tile_h, columns, rows);
+		return &tilemap;
+	}
+
+	void Application::destroyTilemap(void* map)
+	{
+		MLX_PROFILE_FUNCTION();
+		CHECK_TILEMAP_PTR(map, return);
+		Tilemap* tilemap = static_cast<Tilemap*>(map);
+		syncRenderThread();
+		std::unique_lock<std::shared_mutex> lock(_resources_mutex);
+		for(auto& gs : _graphics)
+		{
+			if(gs)
+				gs->tryEraseTilemap(tilemap);
+		}
+		eraseRecordedCommands([=](const RenderCommand& command)
+		{
+			return command.type == RenderCommand::kind::tilemap_put && command.tilemap == tilemap;
+		});
+		tilemap->destroy();
+		_tilemaps.remove_if([=](const Tilemap& other) { return &other == tilemap; });
+	}
+
+	GraphicsSupport* Application::findPixelLayerWindow(void* layer) noexcept
+	{
+		if(layer == nullptr)
+		{
+			core::error::report(e_kind::error, "invalid pixel layer ptr (NULL)");
+			return nullptr;
+		}
+		auto it = _pixel_layers.find(static_cast<PixelLayer*>(layer));
+		if(it == _pixel_layers.end() || !_graphics[it->second])
+		{
+			core::error::report(e_kind::error, "invalid pixel layer ptr");
+			return nullptr;
+		}
+		return _graphics[it->second].get();
+	}
+
+	void* Application::newPixelLayer(void* win, int z)
+	{
+		MLX_PROFILE_FUNCTION();
+		if(win == nullptr || *static_cast<int*>(win) < 0 || *static_cast<int*>(win) >= static_cast<int>(_graphics.size()) || !_graphics[*static_cast<int*>(win)])
+		{
+			core::error::report(e_kind::error, "invalid window ptr");
+			return nullptr;
+		}
+		syncRenderThread();
+		std::unique_lock<std::shared_mutex> lock(_resources_mutex);
+		PixelLayer* layer = _graphics[*static_cast<int*>(win)]->newPixelLayer(z);
+		_pixel_layers[layer] = *static_cast<int*>(win);
+		return layer;
+	}
+
+	void Application::setPixelLayerDepth(void* layer, int z)
+	{
+		MLX_PROFILE_FUNCTION();
+		GraphicsSupport* gs = findPixelLayerWindow(layer);
+		if(gs == nullptr)
+			return;
+		syncRenderThread();
+		gs->setPixelLayerDepth(static_cast<PixelLayer*>(layer), z);
+	}
+
+	void Application::destroyPixelLayer(void* layer)
+	{
+		MLX_PROFILE_FUNCTION();
+		GraphicsSupport* gs = findPixelLayerWindow(layer);
+		if(gs == nullptr)
+			return;
+		syncRenderThread();
+		std::unique_lock<std::shared_mutex> lock(_resources_mutex);
+		eraseRecordedCommands([=](const RenderCommand& command) { return command.layer == layer; });
+		gs->destroyPixelLayer(static_cast<PixelLayer*>(layer));
+		_pixel_layers.erase(static_cast<PixelLayer*>(layer));
+	}
+
+	void Application::parallelForTiles(void* win_or_img, int tile_w, int tile_h, int (*f)(int, int, void*), void* param)
+	{
+		MLX_PROFILE_FUNCTION();
+		if(f == nullptr)
+		{
+			core::error::report(e_kind::error, "invalid tile function (NULL)");
+			return;
+		}
+		if(tile_w <= 0 || tile_h <= 0)
+		{
+			core::error::report(e_kind::error, "invalid tile size (%dx%d)", tile_w, tile_h);
+			return;
+		}
+		if(win_or_img == nullptr)
+		{
+			core::error::report(e_kind::error, "invalid window or image ptr (NULL)");
+			return;
+		}
+
+		syncRenderThread(); // the CPU maps must not be uploaded while the workers write in them
+
+		std::uint32_t* map = nullptr;
+		std::uint32_t width = 0;
+		std::uint32_t height = 0;
+		Texture* texture = nullptr;
+		PixelPutPipeline* pixel_put = nullptr;
+
+		auto it = std::find_if(_textures.begin(), _textures.end(), [=](const Texture& texture) { return &texture == win_or_img; });
+		if(it != _textures.end())
+		{
+			texture = &*it;
+			if(!texture->isInit())
+			{
+				core::error::report(e_kind::error, "trying to run tiles on a texture that has been destroyed");
+				return;
+			}
+			if(isImageLoading(texture))
+			{
+				core::error::report(e_kind::error, "trying to run tiles on a texture that is still loading");
+				return;
+			}
+			detachTexture(texture);
+			map = texture->getCPUMap();
+			width = texture->getWidth();
+			height = texture->getHeight();
+		}
+		else
+		{
+			CHECK_WINDOW_PTR(win_or_img);
+			if(_render_thread.isRunning())
+			{
+				// puts recorded earlier in the frame must land before the tiles, as they would without a render thread
+				replayFramePacket(_render_thread.getRecordingPacket());
+				_render_thread.getRecordingPacket().clear();
+			}
+			pixel_put = &_graphics[*static_cast<int*>(win_or_img)]->getPixelPutPipeline();
+			map = pixel_put->getCPUMap();
+			width = pixel_put->getWidth();
+			height = pixel_put->getHeight();
+		}
+
+		std::uint32_t tiles_x = (width + tile_w - 1) / tile_w;
+		std::uint32_t tiles_y = (height + tile_h - 1) / tile_h;
+		std::vector<std::uint8_t> modified_tiles(tiles_x * tiles_y, 0);
+
+		JobSystem::get().parallelFor(modified_tiles.size(), [&](std::size_t tile)
+		{
+			std::uint32_t x0 = (tile % tiles_x) * tile_w;
+			std::uint32_t y0 = (tile / tiles_x) * tile_h;
+			std::uint32_t x1 = std::min(width, x0 + tile_w);
+			std::uint32_t y1 = std::min(height, y0 + tile_h);
+			bool modified = false;
+			for(std::uint32_t y = y0; y < y1; y++)
+			{
+				std::uint32_t* row = map + static_cast<std::size_t>(y) * width;
+				for(std::uint32_t x = x0; x < x1; x++)
+				{
+					// 0xAARRGGBB to the RGBA bytes layout of the maps
+					std::uint32_t color = static_cast<std::uint32_t>(f(x, y, param));
+					color = (color & 0xFF00FF00) | ((color & 0x00FF0000) >> 16) | ((color & 0x000000FF) << 16);
+					modified |= (row[x] != color);
+					row[x] = color;
+				}
+			}
+			modified_tiles[tile] = modified;
+		});
+
+		VkRect2D area = { { 0, 0 }, { 0, 0 } };
+		for(std::size_t tile = 0; tile < modified_tiles.size(); tile++)
+		{
+			if(!modified_tiles[tile])
+				continue;
+			std::uint32_t x = (tile % tiles_x) * tile_w;
+			std::uint32_t y = (tile / tiles_x) * tile_h;
+			area = rectUnion(area, { { static_cast<std::int32_t>(x), static_cast<std::int32_t>(y) }, { std::min<std::uint32_t>(tile_w, width - x), std::min<std::uint32_t>(tile_h, height - y) } });
+		}
+		if(rectIsEmpty(area))
+			return;
+		if(texture != nullptr)
+			texture->markModified(area);
+		else
+			pixel_put->markModified(area);
+	}
+
+	void* Application::submitJob(void (*job)(void*), void (*on_done)(void*), void* param)
+	{
+		MLX_PROFILE_FUNCTION();
+		if(job == nullptr)
+		{
+			core::error::report(e_kind::error, "invalid job function (NULL)");
+			return nullptr;
+		}
+		JobHandle handle = JobSystem::get().submit([=]() { job(param); });
+		if(on_done != nullptr)
+			handle = JobSystem::get().then(handle, [=]() { on_done(param); }, true);
+		std::uintptr_t id;
+		{
+			std::unique_lock<std::mutex> lock(_user_jobs_mutex);
+			id = ++_user_jobs_count;
+			_user_jobs[id] = handle;
+		}
+		// registered first as the job may already be done, this is then run right away
+		JobSystem::get().then(handle, [=]() { releaseJob(id); });
+		return reinterpret_cast<void*>(id);
+	}
+
+	void Application::releaseJob(std::uintptr_t id)
+	{
+		std::unique_lock<std::mutex> lock(_user_jobs_mutex);
+		_user_jobs.erase(id);
+	}
+
+	void Application::waitJob(void* job)
+	{
+		MLX_PROFILE_FUNCTION();
+		JobHandle handle;
+		{
+			std::unique_lock<std::mutex> lock(_user_jobs_mutex);
+			std::uintptr_t id = reinterpret_cast<std::uintptr_t>(job);
+			auto it = _user_jobs.find(id);
+			if(it == _user_jobs.end())
+			{
+				if(id == 0 || id > _user_jobs_count)
+					core::error::report(e_kind::error, "invalid job ptr");
+				return; // already done and released
+			}
+			handle = it->second;
+		}
+		JobSystem::get().wait(handle);
+	}
+
 	Application::~Application()
 	{
+		_render_thread.stop();
+		JobSystem::get().destroy(); // lets the running jobs end before the resources they may use are released
+		_user_jobs.clear();
+		for(PendingImage& pending : _pending_images)
+		{
+			if(pending.staging_buffer != nullptr)
+				pending.staging_buffer->destroy();
+		}
+		_pending_images.clear();
+		for(Tilemap& tilemap : _tilemaps)
+			tilemap.destroy();
+		_tilemaps.clear();
+		_image_cache.destroy();
+		_image_atlas.destroy();
 		TextLibrary::get().clearLibrary();
 		TextLibrary::get().reset();
 		FontLibrary::get().clearLibrary();
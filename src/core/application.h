@@ -6,16 +6,20 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/10/04 21:49:46 by maldavid          #+#    #+#             */
-/*   Updated: 2024/09/12 01:30:35 by tdelage          ###   ########.fr       */
+/*   Updated: 2026/10/19 04:38:43 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #ifndef __MLX_APPLICATION__
 #define __MLX_APPLICATION__
 
+#include <map>
 #include <list>
+#include <mutex>
+#include <shared_mutex>
 #include <memory>
 #include <vector>
+#include <cstdint>
 #include <functional>
 
 #include <core/errors.h>
@@ -25,6 +29,13 @@
 #include <mlx_profile.h>
 #include <core/profiler.h>
 #include <core/fps.h>
+#include <core/render_thread.h>
+#include <core/put_queues.h>
+#include <core/job_system.h>
+#include <core/asset_pack.h>
+#include <core/image_cache.h>
+#include <thread>
+#include <unordered_map>
 
 namespace mlx::core
 {
@@ -41,38 +52,137 @@ namespace mlx::core
 			inline void getScreenSize(void* win, int* w, int* h) noexcept;
 
 			inline void setFPSCap(std::uint32_t fps) noexcept;
+			inline void setFramesInFlight(std::uint32_t count) noexcept { _frames_in_flight = count; }
+			inline void setThreadOrderKey(int key) { _put_queues.setOrderKey(key); }
+			inline void setRenderOnDemand(bool enable, std::uint32_t idle_timeout_ms) { syncRenderThread(); _render_on_demand = enable; _idle_timeout = idle_timeout_ms; }
+			void setRenderThread(bool enable);
+			inline void getFrameTimeStats(float* mean, float* variance) const noexcept;
+			inline void setPresentMode(void* win, VkPresentModeKHR mode);
+			inline void setDamageTracking(void* win, bool enable);
+			inline void setWindowView(void* win, int x, int y, float zoom);
 
 			inline void* newGraphicsSuport(std::size_t w, std::size_t h, const char* title);
 			inline void clearGraphicsSupport(void* win);
 			inline void destroyGraphicsSupport(void* win);
 			inline void setWindowPosition(void *win, int x, int y);
 
-			inline void pixelPut(void* win, int x, int y, std::uint32_t color) const noexcept;
+			inline void pixelPut(void* win, int x, int y, std::uint32_t color) noexcept;
+			inline void scrollWindowPixels(void* win, int dx, int dy, std::uint32_t fill) noexcept;
 			inline void stringPut(void* win, int x, int y, std::uint32_t color, char* str);
 
+			inline void drawLine(void* win, int x0, int y0, int x1, int y1, int thickness, std::uint32_t color);
+			inline void drawRect(void* win, int x, int y, int w, int h, int thickness, std::uint32_t color);
+			inline void fillRect(void* win, int x, int y, int w, int h, std::uint32_t color);
+			inline void drawCircle(void* win, int x, int y, int radius, int thickness, std::uint32_t color); // a thickness of 0 fills it
+			inline void fillPolygon(void* win, const int* points, int count, std::uint32_t color); // points are x, y pairs
+
 			void* newTexture(int w, int h);
 			void* newStbTexture(char* file, int* w, int* h); // stb textures are format managed by stb image (png, jpg, bpm, ...)
-			inline void texturePut(void* win, void* img, int x, int y);
+			void* newStbTextureFromMemory(const std::uint8_t* data, std::size_t size, int* w, int* h);
+			void loadImagesAsync(char** paths, int count, void** images, void (*on_loaded)(void*, int, int, int, void*), void* param);
+			inline bool isImageReady(void* img);
+			inline void texturePut(void* win, void* img, int x, int y, VkRect2D region = {}, ImageTransform transform = {}); // an empty region puts the whole texture
 			inline int getTexturePixel(void* img, int x, int y);
 			inline void setTexturePixel(void* img, int x, int y, std::uint32_t color);
+			inline void setTextureFilter(void* img, bool linear);
 			void destroyTexture(void* ptr);
+			inline void setImageCache(bool enable) noexcept { _image_cache.enable(enable); }
+
+			void* newTilemap(void* img, int tile_w, int tile_h, int columns, int rows);
+			inline void setTile(void* map, int column, int row, int tile);
+			inline void setTilemapScroll(void* map, int x, int y);
+			inline void tilemapPut(void* win, void* map, int x, int y, int w, int h);
+			void destroyTilemap(void* map);
+
+			void* newPixelLayer(void* win, int z);
+			inline void layerPixelPut(void* layer, int x, int y, std::uint32_t color);
+			inline void clearPixelLayer(void* layer);
+			void setPixelLayerDepth(void* layer, int z);
+			void destroyPixelLayer(void* layer);
+
+			void* openAssetPack(const std::filesystem::path& path);
+			void closeAssetPack(void* pack);
+			void* packToTexture(void* pack, const char* name, int* w, int* h);
+			void* packRegionToTexture(void* pack, const char* name, int* x, int* y, int* w, int* h);
+			void loadPackFont(void* win, void* pack, const char* name);
+
+			void parallelForTiles(void* win_or_img, int tile_w, int tile_h, int (*f)(int, int, void*), void* param);
+			void* submitJob(void (*job)(void*), void (*on_done)(void*), void* param);
+			void waitJob(void* job);
 
 			inline void loopHook(int (*f)(void*), void* param);
 			inline void loopEnd() noexcept;
 
 			inline void loadFont(void* win, const std::filesystem::path& filepath, float scale);
 
+			inline void startRecording(void* win, const std::filesystem::path& filepath, std::uint32_t fps);
+			inline void stopRecording(void* win);
+
 			void run() noexcept;
 
 			~Application();
 
+		private:
+			bool renderFrame() noexcept;
+			void replayFramePacket(FramePacket& packet);
+			void releaseJob(std::uintptr_t id);
+			inline void syncRenderThread();
+			inline bool mustRecordPuts() const noexcept { return _render_thread.isRunning() || std::this_thread::get_id() != _main_thread; }
+			inline std::shared_lock<std::shared_mutex> lockForPut() const; // held by the puts of worker threads for their whole call
+			inline RenderCommand makeCommand(RenderCommand::kind type, void* win, int x = 0, int y = 0, std::uint32_t color = 0) const noexcept;
+			inline void recordCommand(RenderCommand command, const char* str = nullptr, const ImageTransform* transform = nullptr, const std::vector<Vertex>* shape = nullptr);
+			inline void shapePut(void* win, const std::vector<Vertex>& shape);
+			static inline std::vector<Vertex>& getShapeBuffer() noexcept { thread_local std::vector<Vertex> shape; shape.clear(); return shape; } // reused, shapes are often put by thousands
+			void eraseRecordedCommands(const std::function<bool(const RenderCommand&)>& predicate); // keeps puts of destroyed resources from reaching the render thread
+			void uploadLoadedImages();
+			void startImageDecodes(); // as many as the staging budget allows, with the resources mutex held
+			void* newCachedTexture(const std::string& key, const std::function<Texture()>& load, int* w, int* h, const std::uint8_t* content = nullptr, std::size_t content_size = 0);
+			void detachTexture(Texture* texture); // copy on write of the images shared by the cache
+			inline bool isImageLoading(const Texture* texture) const noexcept;
+			AssetPack* findAssetPack(void* pack) noexcept;
+			GraphicsSupport* findPixelLayerWindow(void* layer) noexcept;
+			void* newPackTexture(AssetPack& pack, const pack::Entry& entry);
+
+		private:
+			struct PendingImage
+			{
+				JobFuture<bool> decoding;
+				std::unique_ptr<Buffer> staging_buffer; // persistently mapped, the image is decoded in it, null until the decode starts
+				std::string path;
+				Texture* texture; // nullptr once destroyed by the user
+				void (*on_loaded)(void*, int, int, int, void*);
+				void* param;
+				int width;
+				int height;
+				int index;
+				bool failed = false;
+			};
+
 		private:
 			FpsManager _fps;
+			RenderThread _render_thread;
+			PutQueues _put_queues;
+			FramePacket _queued_puts;
+			std::unordered_map<std::uintptr_t, JobHandle> _user_jobs; // released once done, ids are never reused so late waits stay valid
+			std::uintptr_t _user_jobs_count = 0;
+			std::mutex _user_jobs_mutex;
+			std::thread::id _main_thread;
+			mutable std::shared_mutex _resources_mutex; // the main thread, the only one changing the lists below, locks it exclusively to do so
 			std::list<Texture> _textures;
+			std::list<Tilemap> _tilemaps;
+			std::unordered_map<PixelLayer*, int> _pixel_layers; // owned by their window, mapped to its id
+			std::vector<PendingImage> _pending_images;
+			ImageCache _image_cache;
+			ImageAtlas _image_atlas;
+			std::list<AssetPack> _asset_packs;
+			std::map<std::pair<const AssetPack*, const pack::Entry*>, Texture*> _pack_atlases; // shared by all the regions of an atlas
 			std::vector<std::unique_ptr<GraphicsSupport>> _graphics;
 			std::function<int(void*)> _loop_hook;
 			std::unique_ptr<Input> _in;
 			void* _param = nullptr;
+			std::uint32_t _frames_in_flight = DEFAULT_FRAMES_IN_FLIGHT;
+			std::uint32_t _idle_timeout = 0;
+			bool _render_on_demand = false;
 	};
 }
 
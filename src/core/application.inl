@@ -6,12 +6,13 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/10/04 21:49:46 by maldavid          #+#    #+#             */
-/*   Updated: 2023/04/02 14:56:27 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 04:19:45 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include <SDL2/SDL_video.h>
 #include <algorithm>
+#include <cmath>
 #include <core/application.h>
 
 #define CHECK_WINDOW_PTR(win) \
@@ -41,6 +42,21 @@
 		retval; \
 	} else {}
 
+#define CHECK_TILEMAP_PTR(map, retval) \
+	if(map == nullptr) \
+	{ \
+		core::error::report(e_kind::error, "invalid tilemap ptr (NULL)"); \
+		retval; \
+	} \
+	else if(std::find_if(_tilemaps.begin(), _tilemaps.end(), [=](const Tilemap& tilemap) \
+			{ \
+				return &tilemap == map; \
+			}) == _tilemaps.end()) \
+	{ \
+		core::error::report(e_kind::error, "invalid tilemap ptr"); \
+		retval; \
+	} else {}
+
 namespace mlx::core
 {
 	void Application::getMousePos(int* x, int* y) noexcept
@@ -97,15 +113,133 @@ namespace mlx::core
 		_fps.setMaxFPS(fps);
 	}
 
+	void Application::getFrameTimeStats(float* mean, float* variance) const noexcept
+	{
+		if(mean != nullptr)
+			*mean = static_cast<float>(_fps.getFrameTimeMean());
+		if(variance != nullptr)
+			*variance = static_cast<float>(_fps.getFrameTimeVariance());
+	}
+
+	void Application::syncRenderThread()
+	{
+		if(_render_thread.isRunning())
+			_render_thread.sync();
+	}
+
+	std::shared_lock<std::shared_mutex> Application::lockForPut() const
+	{
+		std::shared_lock<std::shared_mutex> lock(_resources_mutex, std::defer_lock);
+		if(std::this_thread::get_id() != _main_thread) // the main thread does not race with itself
+			lock.lock();
+		return lock;
+	}
+
+	RenderCommand Application::makeCommand(RenderCommand::kind type, void* win, int x, int y, std::uint32_t color) const noexcept
+	{
+		RenderCommand command;
+		command.texture = nullptr;
+		command.tilemap = nullptr;
+		command.layer = nullptr;
+		command.region = {};
+		command.color = color;
+		command.string = 0;
+		command.transform = RenderCommand::NO_TRANSFORM;
+		command.vertices = 0;
+		command.scale = 0.f;
+		command.window = *static_cast<int*>(win);
+		command.x = x;
+		command.y = y;
+		command.type = type;
+		return command;
+	}
+
+	void Application::recordCommand(RenderCommand command, const char* str, const ImageTransform* transform, const std::vector<Vertex>* shape)
+	{
+		if(std::this_thread::get_id() != _main_thread) // merged with other threads puts at the end of the frame
+		{
+			_put_queues.record(command, str, transform, shape);
+			return;
+		}
+		FramePacket& packet = _render_thread.getRecordingPacket();
+		if(shape != nullptr)
+		{
+			packet.pushShape(command, *shape);
+			return;
+		}
+		if(str != nullptr)
+		{
+			command.string = static_cast<std::uint32_t>(packet.strings.size());
+			packet.strings.emplace_back(str);
+		}
+		if(transform != nullptr)
+		{
+			command.transform = static_cast<std::uint32_t>(packet.transforms.size());
+			packet.transforms.push_back(*transform);
+		}
+		packet.commands.push_back(command);
+	}
+
+	void Application::setPresentMode(void* win, VkPresentModeKHR mode)
+	{
+		CHECK_WINDOW_PTR(win);
+		syncRenderThread();
+		if(!_graphics[*static_cast<int*>(win)]->hasWindow())
+		{
+			error::report(e_kind::warning, "trying to change the present mode of a window that is targeting an image and not a real window, this is not allowed");
+			return;
+		}
+		_graphics[*static_cast<int*>(win)]->getRenderer().setPresentMode(mode);
+	}
+
+	void Application::setDamageTracking(void* win, bool enable)
+	{
+		CHECK_WINDOW_PTR(win);
+		syncRenderThread();
+		if(!_graphics[*static_cast<int*>(win)]->hasWindow())
+		{
+			error::report(e_kind::warning, "trying to enable damage tracking on a window that is targeting an image and not a real window, this is not allowed");
+			return;
+		}
+		_graphics[*static_cast<int*>(win)]->setDamageTracking(enable);
+	}
+
+	void Application::setWindowView(void* win, int x, int y, float zoom)
+	{
+		MLX_PROFILE_FUNCTION();
+		std::shared_lock<std::shared_mutex> lock = lockForPut();
+		CHECK_WINDOW_PTR(win);
+		if(!(zoom > 0.f) || std::isinf(zoom))
+		{
+			error::report(e_kind::error, "invalid window view zoom (%f)", zoom);
+			return;
+		}
+		if(mustRecordPuts()) // applied with the puts of the same frame
+		{
+			RenderCommand command = makeCommand(RenderCommand::kind::set_view, win, x, y);
+			command.scale = zoom;
+			recordCommand(command);
+		}
+		else
+			_graphics[*static_cast<int*>(win)]->setView(x, y, zoom);
+	}
+
 	void* Application::newGraphicsSuport(std::size_t w, std::size_t h, const char* title)
 	{
 		MLX_PROFILE_FUNCTION();
+		syncRenderThread();
 		auto it = std::find_if(_textures.begin(), _textures.end(), [=](const Texture& texture)
 		{
 			return &texture == reinterpret_cast<Texture*>(const_cast<char*>(title));
 		});
 		if(it != _textures.end())
-			_graphics.emplace_back(std::make_unique<GraphicsSupport>(w, h, reinterpret_cast<Texture*>(const_cast<char*>(title)), _graphics.size()));
+		{
+			detachTexture(&*it); // rendering in it is a modification
+			std::unique_lock<std::shared_mutex> lock(_resources_mutex);
+			if(it->isInAtlas()) // render passes cover the whole image
+				it->detach();
+			_graphics.emplace_back(std::make_unique<GraphicsSupport>(w, h, reinterpret_cast<Texture*>(const_cast<char*>(title)), _graphics.size(), _frames_in_flight));
+		}
 		else
 		{
 			if(title == NULL)
@@ -113,7 +247,8 @@ namespace mlx::core
 				core::error::report(e_kind::fatal_error, "invalid window title (NULL)");
 				return nullptr;
 			}
-			_graphics.emplace_back(std::make_unique<GraphicsSupport>(w, h, title, _graphics.size()));
+			std::unique_lock<std::shared_mutex> lock(_resources_mutex);
+			_graphics.emplace_back(std::make_unique<GraphicsSupport>(w, h, title, _graphics.size(), _frames_in_flight));
 			_in->addWindow(_graphics.back()->getWindow());
 		}
 		return static_cast<void*>(&_graphics.back()->getID());
@@ -122,27 +257,85 @@ namespace mlx::core
 	void Application::clearGraphicsSupport(void* win)
 	{
 		MLX_PROFILE_FUNCTION();
+		std::shared_lock<std::shared_mutex> lock = lockForPut();
 		CHECK_WINDOW_PTR(win);
-		_graphics[*static_cast<int*>(win)]->clearRenderData();
+		if(mustRecordPuts())
+			recordCommand(makeCommand(RenderCommand::kind::clear, win));
+		else
+			_graphics[*static_cast<int*>(win)]->clearRenderData();
 	}
 
 	void Application::destroyGraphicsSupport(void* win)
 	{
 		MLX_PROFILE_FUNCTION();
 		CHECK_WINDOW_PTR(win);
+		syncRenderThread();
+		std::unique_lock<std::shared_mutex> lock(_resources_mutex);
+		for(auto it = _pixel_layers.begin(); it != _pixel_layers.end();)
+			it = (it->second == *static_cast<int*>(win) ? _pixel_layers.erase(it) : std::next(it));
 		_graphics[*static_cast<int*>(win)].reset();
 	}
 
-	void Application::pixelPut(void* win, int x, int y, std::uint32_t color) const noexcept
+	void Application::pixelPut(void* win, int x, int y, std::uint32_t color) noexcept
 	{
 		MLX_PROFILE_FUNCTION();
+		std::shared_lock<std::shared_mutex> lock = lockForPut();
 		CHECK_WINDOW_PTR(win);
-		_graphics[*static_cast<int*>(win)]->pixelPut(x, y, color);
+		if(mustRecordPuts())
+			recordCommand(makeCommand(RenderCommand::kind::pixel_put, win, x, y, color));
+		else
+			_graphics[*static_cast<int*>(win)]->pixelPut(x, y, color);
+	}
+
+	void Application::layerPixelPut(void* layer, int x, int y, std::uint32_t color)
+	{
+		MLX_PROFILE_FUNCTION();
+		std::shared_lock<std::shared_mutex> lock = lockForPut();
+		GraphicsSupport* gs = findPixelLayerWindow(layer);
+		if(gs == nullptr)
+			return;
+		if(mustRecordPuts())
+		{
+			RenderCommand command = makeCommand(RenderCommand::kind::layer_pixel_put, &gs->getID(), x, y, color);
+			command.layer = static_cast<PixelLayer*>(layer);
+			recordCommand(command);
+		}
+		else
+			gs->layerPixelPut(static_cast<PixelLayer*>(layer), x, y, color);
+	}
+
+	void Application::clearPixelLayer(void* layer)
+	{
+		MLX_PROFILE_FUNCTION();
+		std::shared_lock<std::shared_mutex> lock = lockForPut();
+		GraphicsSupport* gs = findPixelLayerWindow(layer);
+		if(gs == nullptr)
+			return;
+		if(mustRecordPuts())
+		{
+			RenderCommand command = makeCommand(RenderCommand::kind::layer_clear, &gs->getID());
+			command.layer = static_cast<PixelLayer*>(layer);
+			recordCommand(command);
+		}
+		else
+			gs->clearPixelLayer(static_cast<PixelLayer*>(layer));
+	}
+
+	void Application::scrollWindowPixels(void* win, int dx, int dy, std::uint32_t fill) noexcept
+	{
+		MLX_PROFILE_FUNCTION();
+		std::shared_lock<std::shared_mutex> lock = lockForPut();
+		CHECK_WINDOW_PTR(win);
+		if(mustRecordPuts()) // ordered with the pixel puts around it
+			recordCommand(makeCommand(RenderCommand::kind::scroll_pixels, win, dx, dy, fill));
+		else
+			_graphics[*static_cast<int*>(win)]->scrollPixels(dx, dy, fill);
 	}
 
 	void Application::stringPut(void* win, int x, int y, std::uint32_t color, char* str)
 	{
 		MLX_PROFILE_FUNCTION();
+		std::shared_lock<std::shared_mutex> lock = lockForPut();
 		CHECK_WINDOW_PTR(win);
 		if(str == nullptr)
 		{
@@ -154,26 +347,162 @@ namespace mlx::core
 			core::error::report(e_kind::warning, "trying to put an empty text");
 			return;
 		}
-		_graphics[*static_cast<int*>(win)]->stringPut(x, y, color, str);
+		if(mustRecordPuts())
+			recordCommand(makeCommand(RenderCommand::kind::string_put, win, x, y, color), str);
+		else
+			_graphics[*static_cast<int*>(win)]->stringPut(x, y, color, str);
+	}
+
+	void Application::shapePut(void* win, const std::vector<Vertex>& shape)
+	{
+		if(shape.empty())
+			return;
+		if(mustRecordPuts())
+			recordCommand(makeCommand(RenderCommand::kind::shape_put, win), nullptr, nullptr, &shape);
+		else
+			_graphics[*static_cast<int*>(win)]->shapePut(shape.data(), shape.size());
+	}
+
+	void Application::drawLine(void* win, int x0, int y0, int x1, int y1, int thickness, std::uint32_t color)
+	{
+		MLX_PROFILE_FUNCTION();
+		std::shared_lock<std::shared_mutex> lock = lockForPut();
+		CHECK_WINDOW_PTR(win);
+		std::vector<Vertex>& shape = getShapeBuffer();
+		tessellateLine(shape, glm::vec2(x0, y0), glm::vec2(x1, y1), static_cast<float>(thickness), color);
+		shapePut(win, shape);
+	}
+
+	void Application::drawRect(void* win, int x, int y, int w, int h, int thickness, std::uint32_t color)
+	{
+		MLX_PROFILE_FUNCTION();
+		std::shared_lock<std::shared_mutex> lock = lockForPut();
+		CHECK_WINDOW_PTR(win);
+		std::vector<Vertex>& shape = getShapeBuffer();
+		tessellateRect(shape, glm::vec2(x, y), glm::vec2(w, h), static_cast<float>(thickness), color);
+		shapePut(win, shape);
+	}
+
+	void Application::fillRect(void* win, int x, int y, int w, int h, std::uint32_t color)
+	{
+		MLX_PROFILE_FUNCTION();
+		std::shared_lock<std::shared_mutex> lock = lockForPut();
+		CHECK_WINDOW_PTR(win);
+		std::vector<Vertex>& shape = getShapeBuffer();
+		tessellateFilledRect(shape, glm::vec2(x, y), glm::vec2(w, h), color);
+		shapePut(win, shape);
+	}
+
+	void Application::drawCircle(void* win, int x, int y, int radius, int thickness, std::uint32_t color)
+	{
+		MLX_PROFILE_FUNCTION();
+		std::shared_lock<std::shared_mutex> lock = lockForPut();
+		CHECK_WINDOW_PTR(win);
+		std::vector<Vertex>& shape = getShapeBuffer();
+		tessellateCircle(shape, glm::vec2(x, y), static_cast<float>(radius), static_cast<float>(thickness), color);
+		shapePut(win, shape);
+	}
+
+	void Application::fillPolygon(void* win, const int* points, int count, std::uint32_t color)
+	{
+		MLX_PROFILE_FUNCTION();
+		std::shared_lock<std::shared_mutex> lock = lockForPut();
+		CHECK_WINDOW_PTR(win);
+		if(points == nullptr || count < 3)
+		{
+			core::error::report(e_kind::error, "a polygon needs at least 3 points");
+			return;
+		}
+		std::vector<glm::vec2> polygon(count);
+		for(int i = 0; i < count; i++)
+			polygon[i] = glm::vec2(points[i * 2], points[i * 2 + 1]);
+		std::vector<Vertex>& shape = getShapeBuffer();
+		tessellatePolygon(shape, polygon, color);
+		shapePut(win, shape);
 	}
 
 	void Application::loadFont(void* win, const std::filesystem::path& filepath, float scale)
+	{
+		MLX_PROFILE_FUNCTION();
+		std::shared_lock<std::shared_mutex> lock = lockForPut();
+		CHECK_WINDOW_PTR(win);
+		if(mustRecordPuts()) // recorded to only apply to texts put after this call
+		{
+			RenderCommand command = makeCommand(RenderCommand::kind::load_font, win);
+			command.scale = scale;
+			recordCommand(command, filepath.string().c_str());
+		}
+		else
+			_graphics[*static_cast<int*>(win)]->loadFont(filepath, scale);
+	}
+
+	void Application::startRecording(void* win, const std::filesystem::path& filepath, std::uint32_t fps)
+	{
+		MLX_PROFILE_FUNCTION();
+		CHECK_WINDOW_PTR(win);
+		syncRenderThread();
+		_graphics[*static_cast<int*>(win)]->getRenderer().startRecording(filepath, fps);
+	}
+
+	void Application::stopRecording(void* win)
 	{
 		MLX_PROFILE_FUNCTION();
 		CHECK_WINDOW_PTR(win);
-		_graphics[*static_cast<int*>(win)]->loadFont(filepath, scale);
+		syncRenderThread();
+		_graphics[*static_cast<int*>(win)]->getRenderer().stopRecording();
+	}
+
+	bool Application::isImageLoading(const Texture* texture) const noexcept
+	{
+		return std::find_if(_pending_images.begin(), _pending_images.end(), [=](const PendingImage& pending) { return pending.texture == texture; }) != _pending_images.end();
+	}
+
+	bool Application::isImageReady(void* img)
+	{
+		CHECK_IMAGE_PTR(img, return false);
+		return !isImageLoading(static_cast<Texture*>(img)) && static_cast<Texture*>(img)->isInit();
 	}
 
-	void Application::texturePut(void* win, void* img, int x, int y)
+	void Application::texturePut(void* win, void* img, int x, int y, VkRect2D region, ImageTransform transform)
 	{
 		MLX_PROFILE_FUNCTION();
+		std::shared_lock<std::shared_mutex> lock = lockForPut();
 		CHECK_WINDOW_PTR(win);
 		CHECK_IMAGE_PTR(img, return);
 		Texture* texture = static_cast<Texture*>(img);
+		if(isImageLoading(texture)) // put as soon as it is ready
+			return;
 		if(!texture->isInit())
+		{
 			core::error::report(e_kind::error, "trying to put a texture that has been destroyed");
+			return;
+		}
+		if(region.extent.width != 0 && region.extent.height != 0) // clipped to the texture, what is cut on the top left moves the destination
+		{
+			int x0 = std::max(region.offset.x, 0);
+			int y0 = std::max(region.offset.y, 0);
+			int x1 = std::min(region.offset.x + static_cast<int>(region.extent.width), static_cast<int>(texture->getWidth()));
+			int y1 = std::min(region.offset.y + static_cast<int>(region.extent.height), static_cast<int>(texture->getHeight()));
+			if(x1 <= x0 || y1 <= y0)
+				return;
+			if(transform == ImageTransform{})
+			{
+				x += x0 - region.offset.x;
+				y += y0 - region.offset.y;
+			}
+			else // the cut part moves the pivot instead so it is still scaled and rotated around the same point
+				transform.pivot -= glm::vec2(x0 - region.offset.x, y0 - region.offset.y);
+			region = { { x0, y0 }, { static_cast<std::uint32_t>(x1 - x0), static_cast<std::uint32_t>(y1 - y0) } };
+		}
+		if(mustRecordPuts())
+		{
+			RenderCommand command = makeCommand(RenderCommand::kind::texture_put, win, x, y);
+			command.texture = texture;
+			command.region = region;
+			recordCommand(command, nullptr, transform != ImageTransform{} ? &transform : nullptr);
+		}
 		else
-			_graphics[*static_cast<int*>(win)]->texturePut(texture, x, y);
+			_graphics[*static_cast<int*>(win)]->texturePut(texture, x, y, region, transform);
 	}
 
 	int Application::getTexturePixel(void* img, int x, int y)
@@ -181,6 +510,11 @@ namespace mlx::core
 		MLX_PROFILE_FUNCTION();
 		CHECK_IMAGE_PTR(img, return 0);
 		Texture* texture = static_cast<Texture*>(img);
+		if(isImageLoading(texture))
+		{
+			core::error::report(e_kind::error, "trying to get a pixel from a texture that is still loading");
+			return 0;
+		}
 		if(!texture->isInit())
 		{
 			core::error::report(e_kind::error, "trying to get a pixel from texture that has been destroyed");
@@ -194,10 +528,89 @@ namespace mlx::core
 		MLX_PROFILE_FUNCTION();
 		CHECK_IMAGE_PTR(img, return);
 		Texture* texture = static_cast<Texture*>(img);
-		if(!texture->isInit())
+		if(isImageLoading(texture))
+			core::error::report(e_kind::error, "trying to set a pixel on a texture that is still loading");
+		else if(!texture->isInit())
 			core::error::report(e_kind::error, "trying to set a pixel on texture that has been destroyed");
 		else
+		{
+			syncRenderThread(); // the texture may be uploaded by the render thread
+			detachTexture(texture);
 			texture->setPixel(x, y, color);
+		}
+	}
+
+	void Application::setTextureFilter(void* img, bool linear)
+	{
+		MLX_PROFILE_FUNCTION();
+		CHECK_IMAGE_PTR(img, return);
+		Texture* texture = static_cast<Texture*>(img);
+		if(isImageLoading(texture))
+			core::error::report(e_kind::error, "trying to set the filter of a texture that is still loading");
+		else if(!texture->isInit())
+			core::error::report(e_kind::error, "trying to set the filter of a texture that has been destroyed");
+		else
+		{
+			syncRenderThread();
+			detachTexture(texture); // the sampler belongs to the image owner
+			std::unique_lock<std::shared_mutex> lock(_resources_mutex);
+			if(texture->isInAtlas()) // atlas pages are always sampled with the nearest filter
+				texture->detach();
+			texture->setFilter(linear ? VK_FILTER_LINEAR : VK_FILTER_NEAREST);
+		}
+	}
+
+	void Application::setTile(void* map, int column, int row, int tile)
+	{
+		MLX_PROFILE_FUNCTION();
+		CHECK_TILEMAP_PTR(map, return);
+		Tilemap* tilemap = static_cast<Tilemap*>(map);
+		if(column < 0 || row < 0 || static_cast<std::uint32_t>(column) >= tilemap->getColumns() || static_cast<std::uint32_t>(row) >= tilemap->getRows())
+		{
+			core::error::report(e_kind::error, "Tilemap : cell (%d, %d) is out of the %ux%u grid", column, row, tilemap->getColumns(), tilemap->getRows());
+			return;
+		}
+		if(tilemap->getTileset() == nullptr)
+		{
+			core::error::report(e_kind::error, "Tilemap : trying to set a tile in a tilemap whose tileset has been destroyed");
+			return;
+		}
+		std::uint32_t tiles = std::min<std::uint32_t>(tilemap->getTilesCount(), Tilemap::EMPTY_TILE);
+		if(tile < -1 || tile >= static_cast<int>(tiles))
+		{
+			core::error::report(e_kind::error, "Tilemap : tile %d is not in the tileset (%u tiles)", tile, tiles);
+			return;
+		}
+		syncRenderThread(); // the grid may be uploaded by the render thread
+		tilemap->setTile(column, row, (tile < 0 ? Tilemap::EMPTY_TILE : static_cast<std::uint16_t>(tile)));
+	}
+
+	void Application::setTilemapScroll(void* map, int x, int y)
+	{
+		MLX_PROFILE_FUNCTION();
+		CHECK_TILEMAP_PTR(map, return);
+		syncRenderThread();
+		static_cast<Tilemap*>(map)->setScroll(x, y);
+	}
+
+	void Application::tilemapPut(void* win, void* map, int x, int y, int w, int h)
+	{
+		MLX_PROFILE_FUNCTION();
+		std::shared_lock<std::shared_mutex> lock = lockForPut();
+		CHECK_WINDOW_PTR(win);
+		CHECK_TILEMAP_PTR(map, return);
+		Tilemap* tilemap = static_cast<Tilemap*>(map);
+		if(w <= 0 || h <= 0)
+			return;
+		if(mustRecordPuts())
+		{
+			RenderCommand command = makeCommand(RenderCommand::kind::tilemap_put, win, x, y);
+			command.tilemap = tilemap;
+			command.region.extent = { static_cast<std::uint32_t>(w), static_cast<std::uint32_t>(h) };
+			recordCommand(command);
+		}
+		else
+			_graphics[*static_cast<int*>(win)]->tilemapPut(tilemap, x, y, w, h);
 	}
 
 	void Application::loopHook(int (*f)(void*), void* param)
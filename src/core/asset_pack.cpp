@@ -0,0 +1,219 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   asset_pack.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 03:09:26 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/19 03:11:53 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <core/asset_pack.h>
+#include <core/errors.h>
+#include <core/profiler.h>
+#include <algorithm>
+
+#ifdef MLX_PLAT_WINDOWS
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <windows.h>
+#else
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+namespace mlx
+{
+	static bool isInFile(std::uint64_t offset, std::uint64_t size, std::uint64_t file_size) noexcept
+	{
+		return offset <= file_size && size <= file_size - offset;
+	}
+
+	bool AssetPack::open(const std::filesystem::path& path)
+	{
+		MLX_PROFILE_FUNCTION();
+		close();
+		std::string filename = path.string();
+
+		#ifdef MLX_PLAT_WINDOWS
+			HANDLE file = CreateFileW(path.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+			if(file == INVALID_HANDLE_VALUE)
+			{
+				core::error::report(e_kind::error, "Asset pack : unable to open '%s'", filename.c_str());
+				return false;
+			}
+			LARGE_INTEGER file_size;
+			GetFileSizeEx(file, &file_size);
+			HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+			void* data = (mapping != nullptr ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr);
+			if(data == nullptr)
+			{
+				if(mapping != nullptr)
+					CloseHandle(mapping);
+				CloseHandle(file);
+				core::error::report(e_kind::error, "Asset pack : unable to map '%s'", filename.c_str());
+				return false;
+			}
+			_file = file;
+			_mapping = mapping;
+			_size = static_cast<std::size_t>(file_size.QuadPart);
+		#else
+			int fd = ::open(filename.c_str(), O_RDONLY);
+			if(fd < 0)
+			{
+				core::error::report(e_kind::error, "Asset pack : unable to open '%s'", filename.c_str());
+				return false;
+			}
+			struct stat infos;
+			void* data = MAP_FAILED;
+			if(fstat(fd, &infos) == 0 && infos.st_size > 0)
+				data = mmap(nullptr, static_cast<std::size_t>(infos.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+			::close(fd); // the mapping keeps the file alive
+			if(data == MAP_FAILED)
+			{
+				core::error::report(e_kind::error, "Asset pack : unable to map '%s'", filename.c_str());
+				return false;
+			}
+			_size = static_cast<std::size_t>(infos.st_size);
+			madvise(data, _size, MADV_WILLNEED); // starts reading ahead, pixels are read once from start to end
+		#endif
+
+		_data = static_cast<const std::uint8_t*>(data);
+		if(!validate(filename))
+		{
+			close();
+			return false;
+		}
+		const pack::Header* header = reinterpret_cast<const pack::Header*>(_data);
+		_entries = reinterpret_cast<const pack::Entry*>(_data + header->entries_offset);
+		_regions = reinterpret_cast<const pack::Region*>(_data + header->regions_offset);
+		_names = reinterpret_cast<const char*>(_data + header->names_offset);
+		_entries_count = header->entries_count;
+		_regions_count = header->regions_count;
+		return true;
+	}
+
+	bool AssetPack::validate(const std::string& filename) const noexcept
+	{
+		if(_size < sizeof(pack::Header))
+		{
+			core::error::report(e_kind::error, "Asset pack : '%s' is not an asset pack", filename.c_str());
+			return false;
+		}
+		const pack::Header* header = reinterpret_cast<const pack::Header*>(_data);
+		if(header->magic != pack::MAGIC)
+		{
+			core::error::report(e_kind::error, "Asset pack : '%s' is not an asset pack", filename.c_str());
+			return false;
+		}
+		if(header->version != pack::VERSION)
+		{
+			core::error::report(e_kind::error, "Asset pack : '%s' has been made for another version of the MLX (version %u, expected %u)", filename.c_str(), header->version, pack::VERSION);
+			return false;
+		}
+		if(	!isInFile(header->entries_offset, static_cast<std::uint64_t>(header->entries_count) * sizeof(pack::Entry), _size) ||
+			!isInFile(header->regions_offset, static_cast<std::uint64_t>(header->regions_count) * sizeof(pack::Region), _size) ||
+			!isInFile(header->names_offset, header->names_size, _size) ||
+			header->entries_offset % alignof(pack::Entry) != 0 || header->regions_offset % alignof(pack::Region) != 0)
+		{
+			core::error::report(e_kind::error, "Asset pack : '%s' is corrupted", filename.c_str());
+			return false;
+		}
+
+		const pack::Entry* entries = reinterpret_cast<const pack::Entry*>(_data + header->entries_offset);
+		for(std::uint32_t i = 0; i < header->entries_count; i++)
+		{
+			const pack::Entry& entry = entries[i];
+			std::uint64_t pixels_size = static_cast<std::uint64_t>(entry.width) * entry.height;
+			bool valid = isInFile(entry.name_offset, entry.name_size, header->names_size) && isInFile(entry.data_offset, entry.data_size, _size);
+			if(entry.kind == static_cast<std::uint32_t>(pack::EntryKind::image))
+				valid = valid && entry.width != 0 && entry.height != 0 && entry.data_size >= pixels_size * 4;
+			else if(entry.kind == static_cast<std::uint32_t>(pack::EntryKind::font))
+			{
+				valid = valid && entry.width == pack::FONT_ATLAS_SIZE && entry.height == pack::FONT_ATLAS_SIZE && entry.data_size >= pixels_size;
+				valid = valid && entry.glyphs_offset % alignof(pack::Glyph) == 0 && isInFile(entry.glyphs_offset, pack::FONT_CHARS_COUNT * sizeof(pack::Glyph), _size);
+			}
+			else
+				valid = false;
+			if(!valid)
+			{
+				core::error::report(e_kind::error, "Asset pack : '%s' is corrupted (entry %u)", filename.c_str(), i);
+				return false;
+			}
+		}
+
+		const pack::Region* regions = reinterpret_cast<const pack::Region*>(_data + header->regions_offset);
+		for(std::uint32_t i = 0; i < header->regions_count; i++)
+		{
+			const pack::Region& region = regions[i];
+			bool valid = isInFile(region.name_offset, region.name_size, header->names_size) && region.entry < header->entries_count;
+			if(valid)
+			{
+				const pack::Entry& atlas = entries[region.entry];
+				valid = atlas.kind == static_cast<std::uint32_t>(pack::EntryKind::image) && isInFile(region.x, region.width, atlas.width) && isInFile(region.y, region.height, atlas.height);
+			}
+			if(!valid)
+			{
+				core::error::report(e_kind::error, "Asset pack : '%s' is corrupted (region %u)", filename.c_str(), i);
+				return false;
+			}
+		}
+		return true;
+	}
+
+	const pack::Entry* AssetPack::findEntry(std::string_view name) const noexcept
+	{
+		// entries are sorted by name by the packer
+		const pack::Entry* end = _entries + _entries_count;
+		const pack::Entry* it = std::lower_bound(_entries, end, name, [this](const pack::Entry& entry, std::string_view name)
+		{
+			return getName(entry.name_offset, entry.name_size) < name;
+		});
+		if(it == end || getName(it->name_offset, it->name_size) != name)
+			return nullptr;
+		return it;
+	}
+
+	const pack::Region* AssetPack::findRegion(std::string_view name) const noexcept
+	{
+		const pack::Region* end = _regions + _regions_count;
+		const pack::Region* it = std::lower_bound(_regions, end, name, [this](const pack::Region& region, std::string_view name)
+		{
+			return getName(region.name_offset, region.name_size) < name;
+		});
+		if(it == end || getName(it->name_offset, it->name_size) != name)
+			return nullptr;
+		return it;
+	}
+
+	void AssetPack::close() noexcept
+	{
+		if(_data == nullptr)
+			return;
+		#ifdef MLX_PLAT_WINDOWS
+			UnmapViewOfFile(_data);
+			CloseHandle(static_cast<HANDLE>(_mapping));
+			CloseHandle(static_cast<HANDLE>(_file));
+			_mapping = nullptr;
+			_file = nullptr;
+		#else
+			munmap(const_cast<std::uint8_t*>(_data), _size);
+		#endif
+		_data = nullptr;
+		_entries = nullptr;
+		_regions = nullptr;
+		_names = nullptr;
+		_size = 0;
+		_entries_count = 0;
+		_regions_count = 0;
+	}
+
+	AssetPack::~AssetPack()
+	{
+		close();
+	}
+}
@@ -0,0 +1,63 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   asset_pack.h                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 03:09:05 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/19 03:11:53 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef __MLX_ASSET_PACK__
+#define __MLX_ASSET_PACK__
+
+#include <mlx_profile.h>
+#include <filesystem>
+#include <string_view>
+#include <cstdint>
+
+#include <utils/non_copyable.h>
+#include <utils/asset_pack_format.h>
+
+namespace mlx
+{
+	class AssetPack : public NonCopyable
+	{
+		public:
+			AssetPack() = default;
+
+			bool open(const std::filesystem::path& path); // maps the whole file, errors are not fatal
+			void close() noexcept;
+
+			const pack::Entry* findEntry(std::string_view name) const noexcept;
+			const pack::Region* findRegion(std::string_view name) const noexcept;
+
+			inline const pack::Entry& getEntry(std::uint32_t index) const noexcept { return _entries[index]; }
+			inline const std::uint8_t* getData(const pack::Entry& entry) const noexcept { return _data + entry.data_offset; }
+			inline const pack::Glyph* getGlyphs(const pack::Entry& entry) const noexcept { return reinterpret_cast<const pack::Glyph*>(_data + entry.glyphs_offset); }
+			inline std::string_view getName(std::uint32_t offset, std::uint32_t size) const noexcept { return std::string_view(_names + offset, size); }
+			inline bool isOpen() const noexcept { return _data != nullptr; }
+
+			~AssetPack();
+
+		private:
+			bool validate(const std::string& filename) const noexcept;
+
+		private:
+			const std::uint8_t* _data = nullptr;
+			const pack::Entry* _entries = nullptr;
+			const pack::Region* _regions = nullptr;
+			const char* _names = nullptr;
+			std::size_t _size = 0;
+			std::uint32_t _entries_count = 0;
+			std::uint32_t _regions_count = 0;
+			#ifdef MLX_PLAT_WINDOWS
+				void* _file = nullptr;
+				void* _mapping = nullptr;
+			#endif
+	};
+}
+
+#endif
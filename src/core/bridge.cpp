@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/10/04 17:35:20 by maldavid          #+#    #+#             */
-/*   Updated: 2024/09/12 01:29:33 by tdelage          ###   ########.fr       */
+/*   Updated: 2026/10/19 04:09:37 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -15,6 +15,7 @@
 #include "application.h"
 #include <renderer/core/render_core.h>
 #include <filesystem>
+#include <cstring>
 #include <mlx.h>
 #include <core/memory.h>
 #include <mlx_profile.h>
@@ -153,6 +154,51 @@ extern "C"
 		return 0;
 	}
 
+	int mlx_put_image_region_to_window(void* mlx, void* win, void* img, int src_x, int src_y, int src_w, int src_h, int dst_x, int dst_y)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		if(src_w <= 0 || src_h <= 0)
+		{
+			mlx::core::error::report(e_kind::warning, "trying to put an empty image region (%dx%d)", src_w, src_h);
+			return 0;
+		}
+		VkRect2D region = { { src_x, src_y }, { static_cast<std::uint32_t>(src_w), static_cast<std::uint32_t>(src_h) } };
+		static_cast<mlx::core::Application*>(mlx)->texturePut(win, img, dst_x, dst_y, region);
+		return 0;
+	}
+
+	int mlx_put_image_transformed(void* mlx, void* win, void* img, int x, int y, float scale_x, float scale_y, float angle, int pivot_x, int pivot_y, int flip, int tint)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		unsigned char color_bits[4];
+		color_bits[0] = (tint & 0x00FF0000) >> 16;
+		color_bits[1] = (tint & 0x0000FF00) >> 8;
+		color_bits[2] = (tint & 0x000000FF);
+		color_bits[3] = (tint & 0xFF000000) >> 24;
+		mlx::ImageTransform transform;
+		transform.scale = { scale_x, scale_y };
+		transform.pivot = { static_cast<float>(pivot_x), static_cast<float>(pivot_y) };
+		transform.angle = angle;
+		transform.tint = *reinterpret_cast<unsigned int*>(color_bits);
+		transform.flip_x = (flip & MLX_FLIP_X) != 0;
+		transform.flip_y = (flip & MLX_FLIP_Y) != 0;
+		static_cast<mlx::core::Application*>(mlx)->texturePut(win, img, x, y, {}, transform);
+		return 0;
+	}
+
+	int mlx_set_image_filter(void* mlx, void* img, mlx_filter filter)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		switch(filter)
+		{
+			case MLX_FILTER_NEAREST: static_cast<mlx::core::Application*>(mlx)->setTextureFilter(img, false); break;
+			case MLX_FILTER_LINEAR: static_cast<mlx::core::Application*>(mlx)->setTextureFilter(img, true); break;
+
+			default: mlx::core::error::report(e_kind::error, "invalid image filter (%d)", static_cast<int>(filter)); break;
+		}
+		return 0;
+	}
+
 	int mlx_destroy_image(void* mlx, void* img)
 	{
 		MLX_CHECK_APPLICATION_POINTER(mlx);
@@ -202,6 +248,191 @@ extern "C"
 		return static_cast<mlx::core::Application*>(mlx)->newStbTexture(filename, width, height);
 	}
 
+	static bool checkImageBuffer(const void* data, int size, const char* loader)
+	{
+		if(data == nullptr)
+		{
+			mlx::core::error::report(e_kind::error, "%s : buffer is NULL", loader);
+			return false;
+		}
+		if(size <= 0)
+		{
+			mlx::core::error::report(e_kind::error, "%s : invalid buffer size (%d)", loader, size);
+			return false;
+		}
+		return true;
+	}
+
+	static bool bufferStartsWith(const void* data, int size, const char* magic, int magic_size)
+	{
+		return size >= magic_size && std::memcmp(data, magic, magic_size) == 0;
+	}
+
+	void* mlx_png_memory_to_image(void* mlx, const void* data, int size, int* width, int* height)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		if(!checkImageBuffer(data, size, "PNG loader"))
+			return nullptr;
+		if(!bufferStartsWith(data, size, "\x89PNG\r\n\x1a\n", 8))
+		{
+			mlx::core::error::report(e_kind::error, "PNG loader : not a png buffer");
+			return nullptr;
+		}
+		return static_cast<mlx::core::Application*>(mlx)->newStbTextureFromMemory(static_cast<const std::uint8_t*>(data), size, width, height);
+	}
+
+	void* mlx_jpg_memory_to_image(void* mlx, const void* data, int size, int* width, int* height)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		if(!checkImageBuffer(data, size, "JPG loader"))
+			return nullptr;
+		if(!bufferStartsWith(data, size, "\xFF\xD8\xFF", 3))
+		{
+			mlx::core::error::report(e_kind::error, "JPG loader : not a jpg buffer");
+			return nullptr;
+		}
+		return static_cast<mlx::core::Application*>(mlx)->newStbTextureFromMemory(static_cast<const std::uint8_t*>(data), size, width, height);
+	}
+
+	void* mlx_bmp_memory_to_image(void* mlx, const void* data, int size, int* width, int* height)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		if(!checkImageBuffer(data, size, "BMP loader"))
+			return nullptr;
+		if(!bufferStartsWith(data, size, "BM", 2))
+		{
+			mlx::core::error::report(e_kind::error, "BMP loader : not a bmp buffer");
+			return nullptr;
+		}
+		return static_cast<mlx::core::Application*>(mlx)->newStbTextureFromMemory(static_cast<const std::uint8_t*>(data), size, width, height);
+	}
+
+	void* mlx_memory_to_image(void* mlx, const void* data, int size, int* width, int* height)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		if(!checkImageBuffer(data, size, "Image loader"))
+			return nullptr;
+		return static_cast<mlx::core::Application*>(mlx)->newStbTextureFromMemory(static_cast<const std::uint8_t*>(data), size, width, height);
+	}
+
+	int mlx_load_images_async(void* mlx, char** paths, int count, void** images, void (*on_loaded)(void*, int, int, int, void*), void* param)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		if(paths == nullptr || images == nullptr)
+		{
+			mlx::core::error::report(e_kind::error, "invalid paths or images array (NULL)");
+			return 0;
+		}
+		if(count <= 0)
+			return 0;
+		static_cast<mlx::core::Application*>(mlx)->loadImagesAsync(paths, count, images, on_loaded, param);
+		return 0;
+	}
+
+	int mlx_image_is_ready(void* mlx, void* img)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		return static_cast<mlx::core::Application*>(mlx)->isImageReady(img);
+	}
+
+	int mlx_set_image_cache(void* mlx, int enable)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		static_cast<mlx::core::Application*>(mlx)->setImageCache(enable);
+		return 0;
+	}
+
+	void* mlx_new_tilemap(void* mlx, void* tileset, int tile_w, int tile_h, int cols, int rows)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		return static_cast<mlx::core::Application*>(mlx)->newTilemap(tileset, tile_w, tile_h, cols, rows);
+	}
+
+	int mlx_set_tile(void* mlx, void* map, int col, int row, int tile)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		static_cast<mlx::core::Application*>(mlx)->setTile(map, col, row, tile);
+		return 0;
+	}
+
+	int mlx_set_tilemap_scroll(void* mlx, void* map, int x, int y)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		static_cast<mlx::core::Application*>(mlx)->setTilemapScroll(map, x, y);
+		return 0;
+	}
+
+	int mlx_put_tilemap_to_window(void* mlx, void* win, void* map, int x, int y, int w, int h)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		if(w <= 0 || h <= 0)
+		{
+			mlx::core::error::report(e_kind::warning, "trying to put a tilemap in an empty area (%dx%d)", w, h);
+			return 0;
+		}
+		static_cast<mlx::core::Application*>(mlx)->tilemapPut(win, map, x, y, w, h);
+		return 0;
+	}
+
+	int mlx_destroy_tilemap(void* mlx, void* map)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		static_cast<mlx::core::Application*>(mlx)->destroyTilemap(map);
+		return 0;
+	}
+
+	void* mlx_open_asset_pack(void* mlx, const char* path)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		if(path == nullptr)
+		{
+			mlx::core::error::report(e_kind::error, "Asset pack : path is NULL");
+			return nullptr;
+		}
+		return static_cast<mlx::core::Application*>(mlx)->openAssetPack(path);
+	}
+
+	int mlx_close_asset_pack(void* mlx, void* pack)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		static_cast<mlx::core::Application*>(mlx)->closeAssetPack(pack);
+		return 0;
+	}
+
+	void* mlx_pack_to_image(void* mlx, void* pack, const char* name, int* width, int* height)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		if(name == nullptr)
+		{
+			mlx::core::error::report(e_kind::error, "Asset pack : image name is NULL");
+			return nullptr;
+		}
+		return static_cast<mlx::core::Application*>(mlx)->packToTexture(pack, name, width, height);
+	}
+
+	void* mlx_pack_region_to_image(void* mlx, void* pack, const char* name, int* x, int* y, int* width, int* height)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		if(name == nullptr)
+		{
+			mlx::core::error::report(e_kind::error, "Asset pack : image name is NULL");
+			return nullptr;
+		}
+		return static_cast<mlx::core::Application*>(mlx)->packRegionToTexture(pack, name, x, y, width, height);
+	}
+
+	int mlx_set_font_from_pack(void* mlx, void* win, void* pack, const char* name)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		if(name == nullptr)
+		{
+			mlx::core::error::report(e_kind::error, "Asset pack : font name is NULL");
+			return 0;
+		}
+		static_cast<mlx::core::Application*>(mlx)->loadPackFont(win, pack, name);
+		return 0;
+	}
+
 	int mlx_pixel_put(void* mlx, void* win, int x, int y, int color)
 	{
 		MLX_CHECK_APPLICATION_POINTER(mlx);
@@ -214,6 +445,129 @@ extern "C"
 		return 0;
 	}
 
+	void* mlx_new_pixel_layer(void* mlx, void* win, int z)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		return static_cast<mlx::core::Application*>(mlx)->newPixelLayer(win, z);
+	}
+
+	int mlx_layer_pixel_put(void* mlx, void* layer, int x, int y, int color)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		unsigned char color_bits[4];
+		color_bits[0] = (color & 0x00FF0000) >> 16;
+		color_bits[1] = (color & 0x0000FF00) >> 8;
+		color_bits[2] = (color & 0x000000FF);
+		color_bits[3] = (color & 0xFF000000) >> 24;
+		static_cast<mlx::core::Application*>(mlx)->layerPixelPut(layer, x, y, *reinterpret_cast<unsigned int*>(color_bits));
+		return 0;
+	}
+
+	int mlx_clear_pixel_layer(void* mlx, void* layer)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		static_cast<mlx::core::Application*>(mlx)->clearPixelLayer(layer);
+		return 0;
+	}
+
+	int mlx_set_pixel_layer_depth(void* mlx, void* layer, int z)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		static_cast<mlx::core::Application*>(mlx)->setPixelLayerDepth(layer, z);
+		return 0;
+	}
+
+	int mlx_destroy_pixel_layer(void* mlx, void* layer)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		static_cast<mlx::core::Application*>(mlx)->destroyPixelLayer(layer);
+		return 0;
+	}
+
+	int mlx_scroll_window_pixels(void* mlx, void* win, int dx, int dy, int fill_color)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		unsigned char color_bits[4];
+		color_bits[0] = (fill_color & 0x00FF0000) >> 16;
+		color_bits[1] = (fill_color & 0x0000FF00) >> 8;
+		color_bits[2] = (fill_color & 0x000000FF);
+		color_bits[3] = (fill_color & 0xFF000000) >> 24;
+		static_cast<mlx::core::Application*>(mlx)->scrollWindowPixels(win, dx, dy, *reinterpret_cast<unsigned int*>(color_bits));
+		return 0;
+	}
+
+	int mlx_draw_line(void* mlx, void* win, int x0, int y0, int x1, int y1, int thickness, int color)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		unsigned char color_bits[4];
+		color_bits[0] = (color & 0x00FF0000) >> 16;
+		color_bits[1] = (color & 0x0000FF00) >> 8;
+		color_bits[2] = (color & 0x000000FF);
+		color_bits[3] = (color & 0xFF000000) >> 24;
+		static_cast<mlx::core::Application*>(mlx)->drawLine(win, x0, y0, x1, y1, thickness, *reinterpret_cast<unsigned int*>(color_bits));
+		return 0;
+	}
+
+	int mlx_draw_rect(void* mlx, void* win, int x, int y, int width, int height, int thickness, int color)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		unsigned char color_bits[4];
+		color_bits[0] = (color & 0x00FF0000) >> 16;
+		color_bits[1] = (color & 0x0000FF00) >> 8;
+		color_bits[2] = (color & 0x000000FF);
+		color_bits[3] = (color & 0xFF000000) >> 24;
+		static_cast<mlx::core::Application*>(mlx)->drawRect(win, x, y, width, height, thickness, *reinterpret_cast<unsigned int*>(color_bits));
+		return 0;
+	}
+
+	int mlx_fill_rect(void* mlx, void* win, int x, int y, int width, int height, int color)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		unsigned char color_bits[4];
+		color_bits[0] = (color & 0x00FF0000) >> 16;
+		color_bits[1] = (color & 0x0000FF00) >> 8;
+		color_bits[2] = (color & 0x000000FF);
+		color_bits[3] = (color & 0xFF000000) >> 24;
+		static_cast<mlx::core::Application*>(mlx)->fillRect(win, x, y, width, height, *reinterpret_cast<unsigned int*>(color_bits));
+		return 0;
+	}
+
+	int mlx_draw_circle(void* mlx, void* win, int x, int y, int radius, int thickness, int color)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		unsigned char color_bits[4];
+		color_bits[0] = (color & 0x00FF0000) >> 16;
+		color_bits[1] = (color & 0x0000FF00) >> 8;
+		color_bits[2] = (color & 0x000000FF);
+		color_bits[3] = (color & 0xFF000000) >> 24;
+		static_cast<mlx::core::Application*>(mlx)->drawCircle(win, x, y, radius, std::max(thickness, 1), *reinterpret_cast<unsigned int*>(color_bits)); // 0 would fill it
+		return 0;
+	}
+
+	int mlx_fill_circle(void* mlx, void* win, int x, int y, int radius, int color)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		unsigned char color_bits[4];
+		color_bits[0] = (color & 0x00FF0000) >> 16;
+		color_bits[1] = (color & 0x0000FF00) >> 8;
+		color_bits[2] = (color & 0x000000FF);
+		color_bits[3] = (color & 0xFF000000) >> 24;
+		static_cast<mlx::core::Application*>(mlx)->drawCircle(win, x, y, radius, 0, *reinterpret_cast<unsigned int*>(color_bits));
+		return 0;
+	}
+
+	int mlx_fill_polygon(void* mlx, void* win, const int* points, int count, int color)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		unsigned char color_bits[4];
+		color_bits[0] = (color & 0x00FF0000) >> 16;
+		color_bits[1] = (color & 0x0000FF00) >> 8;
+		color_bits[2] = (color & 0x000000FF);
+		color_bits[3] = (color & 0xFF000000) >> 24;
+		static_cast<mlx::core::Application*>(mlx)->fillPolygon(win, points, count, *reinterpret_cast<unsigned int*>(color_bits));
+		return 0;
+	}
+
 	int mlx_string_put(void* mlx, void* win, int x, int y, int color, char* str)
 	{
 		MLX_CHECK_APPLICATION_POINTER(mlx);
@@ -309,4 +663,121 @@ extern "C"
 		static_cast<mlx::core::Application*>(mlx)->setFPSCap(static_cast<std::uint32_t>(fps));
 		return 0;
 	}
+
+	int mlx_set_frames_in_flight(void* mlx, int count)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		if(count <= 0 || count > mlx::MAX_FRAMES_IN_FLIGHT)
+		{
+			mlx::core::error::report(e_kind::error, "invalid frames in flight count (%d), it must be between 1 and %d", count, mlx::MAX_FRAMES_IN_FLIGHT);
+			return 0;
+		}
+		static_cast<mlx::core::Application*>(mlx)->setFramesInFlight(static_cast<std::uint32_t>(count));
+		return 0;
+	}
+
+	int mlx_set_render_on_demand(void* mlx, int enable, int idle_timeout_ms)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		if(idle_timeout_ms < 0)
+		{
+			mlx::core::error::report(e_kind::error, "invalid idle timeout (%d), it must be positive", idle_timeout_ms);
+			return 0;
+		}
+		static_cast<mlx::core::Application*>(mlx)->setRenderOnDemand(enable, static_cast<std::uint32_t>(idle_timeout_ms));
+		return 0;
+	}
+
+	int mlx_set_render_thread(void* mlx, int enable)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		static_cast<mlx::core::Application*>(mlx)->setRenderThread(enable);
+		return 0;
+	}
+
+	int mlx_parallel_for_tiles(void* mlx, void* win_or_img, int tile_w, int tile_h, int (*f)(int, int, void*), void* param)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		static_cast<mlx::core::Application*>(mlx)->parallelForTiles(win_or_img, tile_w, tile_h, f, param);
+		return 0;
+	}
+
+	void* mlx_job_submit(void* mlx, void (*job)(void*), void (*on_done)(void*), void* param)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		return static_cast<mlx::core::Application*>(mlx)->submitJob(job, on_done, param);
+	}
+
+	int mlx_job_wait(void* mlx, void* job)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		static_cast<mlx::core::Application*>(mlx)->waitJob(job);
+		return 0;
+	}
+
+	int mlx_set_thread_order_key(void* mlx, int key)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		static_cast<mlx::core::Application*>(mlx)->setThreadOrderKey(key);
+		return 0;
+	}
+
+	int mlx_set_window_present_mode(void* mlx, void* win, mlx_present_mode mode)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		switch(mode)
+		{
+			case MLX_PRESENT_IMMEDIATE: static_cast<mlx::core::Application*>(mlx)->setPresentMode(win, VK_PRESENT_MODE_IMMEDIATE_KHR); break;
+			case MLX_PRESENT_MAILBOX: static_cast<mlx::core::Application*>(mlx)->setPresentMode(win, VK_PRESENT_MODE_MAILBOX_KHR); break;
+			case MLX_PRESENT_FIFO: static_cast<mlx::core::Application*>(mlx)->setPresentMode(win, VK_PRESENT_MODE_FIFO_KHR); break;
+
+			default: mlx::core::error::report(e_kind::error, "invalid present mode (%d)", static_cast<int>(mode)); break;
+		}
+		return 0;
+	}
+
+	int mlx_set_window_damage_tracking(void* mlx, void* win, int enable)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		static_cast<mlx::core::Application*>(mlx)->setDamageTracking(win, enable);
+		return 0;
+	}
+
+	int mlx_set_window_view(void* mlx, void* win, int offset_x, int offset_y, float zoom)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		static_cast<mlx::core::Application*>(mlx)->setWindowView(win, offset_x, offset_y, zoom);
+		return 0;
+	}
+
+	int mlx_get_frame_time_stats(void* mlx, float* mean, float* variance)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		static_cast<mlx::core::Application*>(mlx)->getFrameTimeStats(mean, variance);
+		return 0;
+	}
+
+	int mlx_start_recording(void* mlx, void* win, const char* filepath, int fps)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		if(filepath == nullptr)
+		{
+			mlx::core::error::report(e_kind::error, "Frame recorder : filepath is NULL");
+			return 0;
+		}
+		if(fps <= 0)
+		{
+			mlx::core::error::report(e_kind::error, "Frame recorder : invalid framerate (%d)", fps);
+			return 0;
+		}
+		static_cast<mlx::core::Application*>(mlx)->startRecording(win, filepath, fps);
+		return 0;
+	}
+
+	int mlx_stop_recording(void* mlx, void* win)
+	{
+		MLX_CHECK_APPLICATION_POINTER(mlx);
+		static_cast<mlx::core::Application*>(mlx)->stopRecording(win);
+		return 0;
+	}
 }
@@ -6,39 +6,86 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/01/18 14:56:17 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/25 16:44:15 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 04:25:33 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include <core/fps.h>
+#include <core/errors.h>
 #include <chrono>
-#include <SDL2/SDL.h>
 #include <thread>
 
 namespace mlx
 {
-	void FpsManager::init()
+	std::uint64_t FpsManager::now() noexcept
 	{
-		_timer = SDL_GetTicks64();
-		_fps_before = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now().time_since_epoch()).count());
-		_fps_now = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now().time_since_epoch()).count());
+		return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count());
 	}
 
-	bool FpsManager::update()
+	void FpsManager::init()
 	{
-		using namespace std::chrono_literals;
-		_fps_now = static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::high_resolution_clock::now().time_since_epoch()).count());
+		_last_frame = now();
+		_deadline = _last_frame + _ns;
+		_frame_times_count = 0;
+		_frame_times_index = 0;
+	}
 
-		if(SDL_GetTicks64() - _timer > 1000)
-			_timer += 1000;
+	void FpsManager::setMaxFPS(std::uint32_t fps) noexcept
+	{
+		if(fps == 0)
+		{
+			core::error::report(e_kind::error, "FPS manager : the FPS cap cannot be 0");
+			return;
+		}
+		_max_fps = fps;
+		_ns = 1'000'000'000 / fps;
+		_deadline = now() + _ns; // the deadline of the previous cap may be far too early or too late
+	}
 
-		_fps_elapsed_time = _fps_now - _fps_before;
-		if(_fps_elapsed_time >= _ns)
+	void FpsManager::update()
+	{
+		std::uint64_t current = now();
+		if(current < _deadline)
 		{
-			_fps_before += _ns;
-			return true;
+			// sleep for the bulk of the wait then spin until the deadline,
+			// sleeping the whole duration would oversleep by the scheduler granularity
+			if(_deadline - current > SPIN_THRESHOLD_NS)
+				std::this_thread::sleep_for(std::chrono::nanoseconds(_deadline - current - SPIN_THRESHOLD_NS));
+			while((current = now()) < _deadline)
+				std::this_thread::yield();
 		}
-		std::this_thread::sleep_for(std::chrono::duration<double, std::nano>(_ns - 1));
-		return false;
+
+		_frame_times[_frame_times_index] = static_cast<double>(current - _last_frame) / 1'000'000.0;
+		_frame_times_index = (_frame_times_index + 1) % FRAME_TIMES_HISTORY_SIZE;
+		if(_frame_times_count < FRAME_TIMES_HISTORY_SIZE)
+			_frame_times_count++;
+		_last_frame = current;
+
+		// deadlines stay on a fixed grid so that a late frame does not shift all the following ones,
+		// unless we are late by more than a whole frame in which case we resynchronise instead of bursting
+		_deadline += _ns;
+		if(_deadline <= current)
+			_deadline = current + _ns;
+	}
+
+	double FpsManager::getFrameTimeMean() const noexcept
+	{
+		if(_frame_times_count == 0)
+			return 0.0;
+		double sum = 0.0;
+		for(std::size_t i = 0; i < _frame_times_count; i++)
+			sum += _frame_times[i];
+		return sum / _frame_times_count;
+	}
+
+	double FpsManager::getFrameTimeVariance() const noexcept
+	{
+		if(_frame_times_count < 2)
+			return 0.0;
+		const double mean = getFrameTimeMean();
+		double sum = 0.0;
+		for(std::size_t i = 0; i < _frame_times_count; i++)
+			sum += (_frame_times[i] - mean) * (_frame_times[i] - mean);
+		return sum / (_frame_times_count - 1);
 	}
 }
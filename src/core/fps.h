@@ -6,13 +6,14 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/01/18 14:53:30 by maldavid          #+#    #+#             */
-/*   Updated: 2024/01/18 15:16:06 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 04:25:33 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #ifndef __MLX_FPS__
 #define __MLX_FPS__
 
+#include <array>
 #include <cstdint>
 
 namespace mlx
@@ -23,18 +24,29 @@ namespace mlx
 			FpsManager() = default;
 
 			void init();
-			bool update();
-			inline void setMaxFPS(std::uint32_t fps) noexcept { _max_fps = fps; _ns = 1000000000.0 / fps; }
+			void update(); // blocks until the next frame is due
+			void setMaxFPS(std::uint32_t fps) noexcept; // the next frame is scheduled one new frame time from now
+
+			inline std::uint32_t getMaxFPS() const noexcept { return _max_fps; }
+			double getFrameTimeMean() const noexcept; // in milliseconds
+			double getFrameTimeVariance() const noexcept; // in squared milliseconds
 
 			~FpsManager() = default;
 
 		private:
-			double _ns = 1000000000.0 / 1'337'000.0;
-			std::uint64_t _timer = 0;
-			std::uint64_t _fps_before = 0;
-			std::uint64_t _fps_now = 0;
+			static std::uint64_t now() noexcept;
+
+		private:
+			static constexpr const std::size_t FRAME_TIMES_HISTORY_SIZE = 128;
+			static constexpr const std::uint64_t SPIN_THRESHOLD_NS = 2'000'000; // sleep granularity of most schedulers
+
+			std::array<double, FRAME_TIMES_HISTORY_SIZE> _frame_times;
+			std::size_t _frame_times_count = 0;
+			std::size_t _frame_times_index = 0;
+			std::uint64_t _ns = 1'000'000'000 / 1'337'000;
+			std::uint64_t _deadline = 0;
+			std::uint64_t _last_frame = 0;
 			std::uint32_t _max_fps = 1'337'000;
-			std::uint32_t _fps_elapsed_time = 0;
 	};
 }
 
@@ -6,15 +6,17 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/04/02 15:13:55 by maldavid          #+#    #+#             */
-/*   Updated: 2024/04/22 17:34:27 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 04:09:37 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include <core/graphics.h>
+#include <utils/combine_hash.h>
+#include <algorithm>
 
 namespace mlx
 {
-	GraphicsSupport::GraphicsSupport(std::size_t w, std::size_t h, Texture* render_target, int id) :
+	GraphicsSupport::GraphicsSupport(std::size_t w, std::size_t h, Texture* render_target, int id, std::uint32_t frames_in_flight) :
 		_window(nullptr),
 		_renderer(std::make_unique<Renderer>()),
 		_width(w),
@@ -24,12 +26,12 @@ namespace mlx
 	{
 		MLX_PROFILE_FUNCTION();
 		_renderer->setWindow(nullptr);
-		_renderer->init(render_target);
+		_renderer->init(render_target, frames_in_flight);
 		_pixel_put_pipeline.init(w, h, *_renderer);
 		_text_manager.init(*_renderer);
 	}
 
-	GraphicsSupport::GraphicsSupport(std::size_t w, std::size_t h, std::string title, int id) :
+	GraphicsSupport::GraphicsSupport(std::size_t w, std::size_t h, std::string title, int id, std::uint32_t frames_in_flight) :
 		_window(std::make_shared<MLX_Window>(w, h, title)),
 		_renderer(std::make_unique<Renderer>()), 
 		_width(w),
@@ -39,17 +41,98 @@ namespace mlx
 	{
 		MLX_PROFILE_FUNCTION();
 		_renderer->setWindow(_window.get());
-		_renderer->init(nullptr);
+		_renderer->init(nullptr, frames_in_flight);
 		_pixel_put_pipeline.init(w, h, *_renderer);
 		_text_manager.init(*_renderer);
 	}
 
-	void GraphicsSupport::render() noexcept
+	std::size_t GraphicsSupport::computeDrawlistSignature() const noexcept
 	{
 		MLX_PROFILE_FUNCTION();
+		std::size_t signature = 0;
+		for(const auto& data : _drawlist)
+			hashCombine(signature, data->getSignature());
+		return signature;
+	}
+
+	VkRect2D GraphicsSupport::computeDamage(const std::vector<DrawnResource>& drawn, std::size_t signature) const
+	{
+		MLX_PROFILE_FUNCTION();
+		VkRect2D full = { { 0, 0 }, { static_cast<std::uint32_t>(_width), static_cast<std::uint32_t>(_height) } };
+		if(_force_redraw)
+			return full;
+
+		// entries are matched by signature, what only appears in one of the lists has been added, removed, moved or modified
+		auto by_signature = [](const DrawnResource& a, const DrawnResource& b) { return a.signature < b.signature; };
+		std::vector<DrawnResource> current = drawn;
+		std::vector<DrawnResource> previous = _last_drawn;
+		std::sort(current.begin(), current.end(), by_signature);
+		std::sort(previous.begin(), previous.end(), by_signature);
+
+		VkRect2D damage = { { 0, 0 }, { 0, 0 } };
+		bool same_resources = true;
+		auto cur = current.begin();
+		auto prev = previous.begin();
+		while(cur != current.end() || prev != previous.end())
+		{
+			if(prev == previous.end() || (cur != current.end() && cur->signature < prev->signature))
+				damage = rectUnion(damage, (cur++)->bounds);
+			else if(cur == current.end() || prev->signature < cur->signature)
+				damage = rectUnion(damage, (prev++)->bounds);
+			else
+			{
+				++cur;
+				++prev;
+				continue;
+			}
+			same_resources = false;
+		}
+		if(same_resources && signature != _last_drawlist_signature) // same puts in another order, overlapping ones may be drawn differently
+			return full;
+		damage = rectUnion(damage, _pixel_put_pipeline.getModifiedArea());
+		for(const PixelLayer& layer : _pixel_layers)
+			damage = rectUnion(damage, layer.pipeline.getModifiedArea());
+		return damage;
+	}
+
+	VkRect2D GraphicsSupport::viewToWindow(const VkRect2D& bounds) const noexcept
+	{
+		if(_view_offset == glm::ivec2(0, 0) && _view_zoom == 1.f)
+			return bounds;
+		glm::vec2 min = (glm::vec2(bounds.offset.x, bounds.offset.y) - glm::vec2(_view_offset)) * _view_zoom;
+		glm::vec2 max = min + glm::vec2(bounds.extent.width, bounds.extent.height) * _view_zoom;
+		min = glm::floor(min);
+		max = glm::ceil(max);
+		return { { static_cast<std::int32_t>(min.x), static_cast<std::int32_t>(min.y) }, { static_cast<std::uint32_t>(max.x - min.x), static_cast<std::uint32_t>(max.y - min.y) } };
+	}
+
+	bool GraphicsSupport::render(bool only_if_changed) noexcept
+	{
+		MLX_PROFILE_FUNCTION();
+		bool track_damage = _renderer->isTrackingDamage();
+		if(track_damage && _renderer->hasLostPreviousFrame())
+			_force_redraw = true;
+		std::size_t signature = computeDrawlistSignature();
+		bool has_changed = _force_redraw || _pixel_put_pipeline.hasBeenModified() || signature != _last_drawlist_signature;
+		for(const PixelLayer& layer : _pixel_layers)
+			has_changed |= layer.pipeline.hasBeenModified();
+		if(!has_changed && (only_if_changed || track_damage)) // with damage tracking the previous frame is still valid
+			return false;
+
+		std::vector<DrawnResource> drawn;
+		if(track_damage)
+		{
+			drawn.reserve(_drawlist.size());
+			for(const auto& data : _drawlist)
+				drawn.push_back({ data->getSignature(), viewToWindow(data->getBounds()) });
+			_renderer->setFrameDamage(computeDamage(drawn, signature));
+		}
+
 		if(!_renderer->beginFrame())
-			return;
+			return false;
 		_proj = glm::ortho<float>(0, _width, 0, _height);
+		_proj = glm::scale(_proj, glm::vec3(_view_zoom, _view_zoom, 1.f));
+		_proj = glm::translate(_proj, glm::vec3(-glm::vec2(_view_offset), 0.f));
 		_renderer->getUniformBuffer()->setData(sizeof(_proj), &_proj);
 
 		std::array<VkDescriptorSet, 2> sets = {
@@ -57,16 +140,31 @@ namespace mlx
 			VK_NULL_HANDLE
 		};
 
-		for(auto& data : _drawlist)
-			data->render(sets, *_renderer);
+		auto layer = _pixel_layers.begin();
+		for(; layer != _pixel_layers.end() && layer->z < 0; ++layer)
+			renderPixels(sets, layer->pipeline);
 
-		_pixel_put_pipeline.render(sets, *_renderer);
+		VkRect2D damage = _renderer->getFrameDamage();
+		for(std::size_t i = 0; i < _drawlist.size(); i++)
+		{
+			if(track_damage && !rectIntersects(drawn[i].bounds, damage)) // would be entirely scissored out
+				continue;
+			_drawlist[i]->render(sets, *_renderer);
+		}
+
+		renderPixels(sets, _pixel_put_pipeline);
+		for(; layer != _pixel_layers.end(); ++layer)
+			renderPixels(sets, layer->pipeline);
 
 		_renderer->endFrame();
 
 		for(auto& data : _drawlist)
 			data->resetUpdate();
 
+		_last_drawlist_signature = signature;
+		_last_drawn = std::move(drawn);
+		_force_redraw = false;
+
 		#ifdef GRAPHICS_MEMORY_DUMP
 			// dump memory to file every two seconds
 			static std::uint64_t timer = SDL_GetTicks64();
@@ -76,6 +174,52 @@ namespace mlx
 				timer += 2000;
 			}
 		#endif
+		return true;
+	}
+
+	void GraphicsSupport::renderPixels(std::array<VkDescriptorSet, 2>& sets, PixelPutPipeline& pipeline)
+	{
+		pipeline.render(sets, *_renderer, _view_offset.x, _view_offset.y, 1.f / _view_zoom); // pinned to the window whatever the view
+	}
+
+	void GraphicsSupport::insertPixelLayer(std::list<PixelLayer>& from, std::list<PixelLayer>::iterator layer)
+	{
+		auto pos = std::find_if(_pixel_layers.begin(), _pixel_layers.end(), [&](const PixelLayer& other) { return other.z > layer->z; });
+		_pixel_layers.splice(pos, from, layer);
+		_force_redraw = true;
+	}
+
+	PixelLayer* GraphicsSupport::newPixelLayer(int z)
+	{
+		MLX_PROFILE_FUNCTION();
+		std::list<PixelLayer> created(1);
+		PixelLayer& layer = created.front();
+		layer.z = z;
+		layer.pipeline.init(_width, _height, *_renderer);
+		insertPixelLayer(created, created.begin());
+		return &layer;
+	}
+
+	void GraphicsSupport::setPixelLayerDepth(PixelLayer* layer, int z)
+	{
+		MLX_PROFILE_FUNCTION();
+		auto it = std::find_if(_pixel_layers.begin(), _pixel_layers.end(), [=](const PixelLayer& other) { return &other == layer; });
+		if(it == _pixel_layers.end() || it->z == z)
+			return;
+		it->z = z;
+		insertPixelLayer(_pixel_layers, it); // last of its new depth
+	}
+
+	void GraphicsSupport::destroyPixelLayer(PixelLayer* layer)
+	{
+		MLX_PROFILE_FUNCTION();
+		auto it = std::find_if(_pixel_layers.begin(), _pixel_layers.end(), [=](const PixelLayer& other) { return &other == layer; });
+		if(it == _pixel_layers.end())
+			return;
+		vkDeviceWaitIdle(Render_Core::get().getDevice().get()); // its texture may still be used by frames in flight
+		it->pipeline.destroy();
+		_pixel_layers.erase(it);
+		_force_redraw = true;
 	}
 
 	GraphicsSupport::~GraphicsSupport()
@@ -84,6 +228,10 @@ namespace mlx
 		vkDeviceWaitIdle(Render_Core::get().getDevice().get());
 		_text_manager.destroy();
 		_pixel_put_pipeline.destroy();
+		for(PixelLayer& layer : _pixel_layers)
+			layer.pipeline.destroy();
+		for(auto& batch : _shape_batches)
+			batch->destroy();
 		_renderer->destroy();
 		if(_window)
 			_window->destroy();
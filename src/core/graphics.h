@@ -6,15 +6,17 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/04/02 14:49:49 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/24 14:43:09 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 04:09:37 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #ifndef __MLX_GRAPHICS__
 #define __MLX_GRAPHICS__
 
+#include <list>
 #include <memory>
 #include <filesystem>
+#include <unordered_set>
 
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
@@ -22,11 +24,14 @@
 #include <platform/window.h>
 #include <renderer/renderer.h>
 #include <renderer/pixel_put.h>
+#include <renderer/shape_batch.h>
 #include <renderer/core/drawable_resource.h>
+#include <utils/rect.h>
 #include <renderer/images/texture_manager.h>
 #include <renderer/texts/text_manager.h>
 #include <utils/non_copyable.h>
 #include <renderer/images/texture.h>
+#include <renderer/images/tilemap.h>
 #include <mlx_profile.h>
 #include <core/profiler.h>
 
@@ -35,36 +40,72 @@ namespace mlx
 	class GraphicsSupport : public NonCopyable
 	{
 		public:
-			GraphicsSupport(std::size_t w, std::size_t h, Texture* render_target, int id);
-			GraphicsSupport(std::size_t w, std::size_t h, std::string title, int id);
+			GraphicsSupport(std::size_t w, std::size_t h, Texture* render_target, int id, std::uint32_t frames_in_flight);
+			GraphicsSupport(std::size_t w, std::size_t h, std::string title, int id, std::uint32_t frames_in_flight);
 
 			inline int& getID() noexcept;
 			inline std::shared_ptr<MLX_Window> getWindow();
 
-			void render() noexcept;
+			bool render(bool only_if_changed = false) noexcept; // returns true if a frame has been rendered
+			inline void requireRedraw() noexcept { _force_redraw = true; }
+			inline void setDamageTracking(bool enable) { _renderer->setDamageTracking(enable); _force_redraw = true; }
+			inline void setView(int x, int y, float zoom) noexcept;
 
 			inline void clearRenderData() noexcept;
 			inline void pixelPut(int x, int y, std::uint32_t color) noexcept;
+			inline void scrollPixels(int dx, int dy, std::uint32_t fill) noexcept;
 			inline void stringPut(int x, int y, std::uint32_t color, std::string str);
-			inline void texturePut(Texture* texture, int x, int y);
+			inline void texturePut(Texture* texture, int x, int y, VkRect2D region = {}, const ImageTransform& transform = {});
+			inline void tilemapPut(Tilemap* tilemap, int x, int y, std::uint32_t width, std::uint32_t height);
+			inline void shapePut(const Vertex* vertices, std::size_t count); // consecutive shapes are drawn in a single call
 			inline void loadFont(const std::filesystem::path& filepath, float scale);
+			inline void loadBakedFont(const std::string& name, float scale, const stbtt_packedchar* cdata, const std::uint8_t* bitmap);
 			inline void tryEraseTextureFromManager(Texture* texture) noexcept;
+			inline void tryEraseTilemap(Tilemap* tilemap) noexcept;
+
+			PixelLayer* newPixelLayer(int z);
+			void setPixelLayerDepth(PixelLayer* layer, int z);
+			void destroyPixelLayer(PixelLayer* layer);
+			inline void layerPixelPut(PixelLayer* layer, int x, int y, std::uint32_t color) noexcept { layer->pipeline.setPixel(x, y, color); }
+			inline void clearPixelLayer(PixelLayer* layer) { layer->pipeline.clear(); }
 
 			inline bool hasWindow() const noexcept  { return _has_window; }
 
 			inline Renderer& getRenderer() { return *_renderer; }
+			inline PixelPutPipeline& getPixelPutPipeline() noexcept { return _pixel_put_pipeline; }
 
 			~GraphicsSupport();
 
+		private:
+			struct DrawnResource
+			{
+				std::size_t signature;
+				VkRect2D bounds;
+			};
+
+		private:
+			std::size_t computeDrawlistSignature() const noexcept;
+			VkRect2D computeDamage(const std::vector<DrawnResource>& drawn, std::size_t signature) const;
+			VkRect2D viewToWindow(const VkRect2D& bounds) const noexcept;
+			void renderPixels(std::array<VkDescriptorSet, 2>& sets, PixelPutPipeline& pipeline);
+			void insertPixelLayer(std::list<PixelLayer>& from, std::list<PixelLayer>::iterator layer);
+
 		private:
 			PixelPutPipeline _pixel_put_pipeline;
+			std::list<PixelLayer> _pixel_layers; // sorted by z, then by creation order
 
 			std::vector<DrawableResource*> _drawlist;
+			std::vector<DrawnResource> _last_drawn; // what the previous frame showed, used to find damaged areas
 			
 			TextManager _text_manager;
 			TextureManager _texture_manager;
+			std::unordered_set<TilemapRenderDescriptor> _tilemap_descriptors;
+			std::vector<std::unique_ptr<ShapeBatch>> _shape_batches; // kept across clears with their buffers
+			std::size_t _used_shape_batches = 0;
 			
 			glm::mat4 _proj = glm::mat4(1.0);
+			glm::ivec2 _view_offset = { 0, 0 }; // point of the world shown at the top left of the window
+			float _view_zoom = 1.f;
 			
 			std::shared_ptr<MLX_Window> _window;
 			std::unique_ptr<Renderer> _renderer;
@@ -72,9 +113,12 @@ namespace mlx
 			std::size_t _width = 0;
 			std::size_t _height = 0;
 			
+			std::size_t _last_drawlist_signature = 0;
+
 			int _id;
 
 			bool _has_window;
+			bool _force_redraw = true;
 	};
 }
 
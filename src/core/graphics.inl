@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/04/02 15:13:55 by maldavid          #+#    #+#             */
-/*   Updated: 2023/04/02 15:26:16 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 04:09:37 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -18,6 +18,15 @@ namespace mlx
 	int& GraphicsSupport::getID() noexcept { return _id; }
 	std::shared_ptr<MLX_Window> GraphicsSupport::getWindow() { return _window; }
 
+	void GraphicsSupport::setView(int x, int y, float zoom) noexcept
+	{
+		if(_view_offset == glm::ivec2(x, y) && _view_zoom == zoom)
+			return;
+		_view_offset = glm::ivec2(x, y);
+		_view_zoom = zoom;
+		_force_redraw = true; // everything moves on the window
+	}
+
 	void GraphicsSupport::clearRenderData() noexcept
 	{
 		MLX_PROFILE_FUNCTION();
@@ -25,6 +34,10 @@ namespace mlx
 		_pixel_put_pipeline.clear();
 		_text_manager.clear();
 		_texture_manager.clear();
+		_tilemap_descriptors.clear();
+		for(std::size_t i = 0; i < _used_shape_batches; i++)
+			_shape_batches[i]->clear();
+		_used_shape_batches = 0;
 	}
 
 	void GraphicsSupport::pixelPut(int x, int y, std::uint32_t color) noexcept
@@ -33,6 +46,12 @@ namespace mlx
 		_pixel_put_pipeline.setPixel(x, y, color);
 	}
 
+	void GraphicsSupport::scrollPixels(int dx, int dy, std::uint32_t fill) noexcept
+	{
+		MLX_PROFILE_FUNCTION();
+		_pixel_put_pipeline.scroll(dx, dy, fill);
+	}
+
 	void GraphicsSupport::stringPut(int x, int y, std::uint32_t color, std::string str)
 	{
 		MLX_PROFILE_FUNCTION();
@@ -46,10 +65,10 @@ namespace mlx
 		_drawlist.push_back(res.first);
 	}
 
-	void GraphicsSupport::texturePut(Texture* texture, int x, int y)
+	void GraphicsSupport::texturePut(Texture* texture, int x, int y, VkRect2D region, const ImageTransform& transform)
 	{
 		MLX_PROFILE_FUNCTION();
-		auto res = _texture_manager.registerTexture(texture, x, y);
+		auto res = _texture_manager.registerTexture(texture, x, y, region, transform);
 		if(!res.second) // if this is not a completly new texture draw
 		{
 			auto it = std::find(_drawlist.begin(), _drawlist.end(), res.first);
@@ -59,12 +78,47 @@ namespace mlx
 		_drawlist.push_back(res.first);
 	}
 
+	void GraphicsSupport::tilemapPut(Tilemap* tilemap, int x, int y, std::uint32_t width, std::uint32_t height)
+	{
+		MLX_PROFILE_FUNCTION();
+		auto res = _tilemap_descriptors.emplace(tilemap, x, y, width, height);
+		DrawableResource* drawable = &const_cast<TilemapRenderDescriptor&>(*res.first);
+		if(!res.second) // if this is not a completly new tilemap draw
+		{
+			auto it = std::find(_drawlist.begin(), _drawlist.end(), drawable);
+			if(it != _drawlist.end())
+				_drawlist.erase(it);
+		}
+		_drawlist.push_back(drawable);
+	}
+
+	void GraphicsSupport::shapePut(const Vertex* vertices, std::size_t count)
+	{
+		MLX_PROFILE_FUNCTION();
+		if(count == 0)
+			return;
+		// a shape following another one joins its batch, anything put in between starts a new one to keep the order
+		if(_used_shape_batches == 0 || _drawlist.empty() || _drawlist.back() != _shape_batches[_used_shape_batches - 1].get())
+		{
+			if(_used_shape_batches == _shape_batches.size())
+				_shape_batches.push_back(std::make_unique<ShapeBatch>());
+			_drawlist.push_back(_shape_batches[_used_shape_batches++].get());
+		}
+		_shape_batches[_used_shape_batches - 1]->add(vertices, count);
+	}
+
 	void GraphicsSupport::loadFont(const std::filesystem::path& filepath, float scale)
 	{
 		MLX_PROFILE_FUNCTION();
 		_text_manager.loadFont(*_renderer, filepath, scale);
 	}
 
+	void GraphicsSupport::loadBakedFont(const std::string& name, float scale, const stbtt_packedchar* cdata, const std::uint8_t* bitmap)
+	{
+		MLX_PROFILE_FUNCTION();
+		_text_manager.loadFont(std::make_shared<Font>(*_renderer, name, scale, cdata, bitmap));
+	}
+
 	void GraphicsSupport::tryEraseTextureFromManager(Texture* texture) noexcept
 	{
 		MLX_PROFILE_FUNCTION();
@@ -77,4 +131,19 @@ namespace mlx
 		}
 		_texture_manager.eraseTextures(texture);
 	}
+
+	void GraphicsSupport::tryEraseTilemap(Tilemap* tilemap) noexcept
+	{
+		MLX_PROFILE_FUNCTION();
+		for(auto it = _tilemap_descriptors.begin(); it != _tilemap_descriptors.end();)
+		{
+			if(it->tilemap != tilemap)
+			{
+				++it;
+				continue;
+			}
+			_drawlist.erase(std::remove(_drawlist.begin(), _drawlist.end(), static_cast<const DrawableResource*>(&*it)), _drawlist.end());
+			it = _tilemap_descriptors.erase(it);
+		}
+	}
 }
@@ -0,0 +1,98 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   image_cache.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 03:15:19 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/19 04:25:15 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <core/image_cache.h>
+#include <core/profiler.h>
+#include <renderer/core/render_core.h>
+#include <cstdio>
+#include <algorithm>
+
+namespace mlx
+{
+	std::string ImageCache::fileKey(const std::filesystem::path& file)
+	{
+		std::error_code error;
+		std::filesystem::path path = std::filesystem::canonical(file, error);
+		if(error)
+			return {};
+		auto time = std::filesystem::last_write_time(path, error);
+		if(error)
+			return {};
+		return path.string() + '@' + std::to_string(time.time_since_epoch().count());
+	}
+
+	std::string ImageCache::memoryKey(const std::uint8_t* data, std::size_t size) const
+	{
+		std::uint64_t hash = 0xCBF29CE484222325; // FNV-1a
+		for(std::size_t i = 0; i < size; i++)
+		{
+			hash ^= data[i];
+			hash *= 0x100000001B3;
+		}
+		char key[64];
+		std::snprintf(key, sizeof(key), "memory:%016llx:%zu", static_cast<unsigned long long>(hash), size);
+		// on a collision the contents differ, the next free or matching key is used
+		for(std::size_t collision = 0;; collision++)
+		{
+			std::string candidate = (collision == 0 ? std::string(key) : std::string(key) + '#' + std::to_string(collision));
+			auto it = _entries.find(candidate);
+			if(it == _entries.end() || std::equal(data, data + size, it->second.content.begin(), it->second.content.end()))
+				return candidate;
+		}
+	}
+
+	Texture* ImageCache::find(const std::string& key) noexcept
+	{
+		auto it = _entries.find(key);
+		if(it == _entries.end())
+			return nullptr;
+		return &it->second.texture;
+	}
+
+	Texture& ImageCache::insert(const std::string& key, Texture&& texture, const std::uint8_t* content, std::size_t content_size)
+	{
+		Entry& entry = _entries[key];
+		entry.texture = std::move(texture);
+		if(content != nullptr)
+			entry.content.assign(content, content + content_size);
+		return entry.texture;
+	}
+
+	void ImageCache::addAlias(const std::string& key, const Texture* alias)
+	{
+		_entries[key].aliases++;
+		_aliases[alias] = key;
+	}
+
+	void ImageCache::release(const Texture* alias) noexcept
+	{
+		MLX_PROFILE_FUNCTION();
+		auto it = _aliases.find(alias);
+		if(it == _aliases.end())
+			return;
+		auto entry = _entries.find(it->second);
+		_aliases.erase(it);
+		if(entry == _entries.end() || --entry->second.aliases != 0)
+			return;
+		vkDeviceWaitIdle(Render_Core::get().getDevice().get()); // the image may still be used by frames in flight
+		entry->second.texture.destroy();
+		_entries.erase(entry);
+	}
+
+	void ImageCache::destroy() noexcept
+	{
+		for(auto& [key, entry] : _entries)
+			entry.texture.destroy();
+		_entries.clear();
+		_aliases.clear();
+	}
+}
@@ -0,0 +1,63 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   image_cache.h                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 03:15:19 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/19 04:25:15 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef __MLX_IMAGE_CACHE__
+#define __MLX_IMAGE_CACHE__
+
+#include <mlx_profile.h>
+#include <filesystem>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+
+#include <utils/non_copyable.h>
+#include <renderer/images/texture.h>
+
+namespace mlx
+{
+	// images loaded several times share the same GPU image, the user gets aliases of it
+	class ImageCache : public NonCopyable
+	{
+		public:
+			ImageCache() = default;
+
+			static std::string fileKey(const std::filesystem::path& file); // canonical path and last write time, empty on error
+			std::string memoryKey(const std::uint8_t* data, std::size_t size) const; // hash of the content, a suffix tells colliding contents apart
+
+			inline void enable(bool enable) noexcept { _enabled = enable; }
+			inline bool isEnabled() const noexcept { return _enabled; }
+
+			Texture* find(const std::string& key) noexcept;
+			Texture& insert(const std::string& key, Texture&& texture, const std::uint8_t* content = nullptr, std::size_t content_size = 0); // memory images keep their content for memoryKey
+			void addAlias(const std::string& key, const Texture* alias);
+			void release(const Texture* alias) noexcept; // the shared image is destroyed with its last alias
+			void destroy() noexcept;
+
+			~ImageCache() = default;
+
+		private:
+			struct Entry
+			{
+				Texture texture;
+				std::vector<std::uint8_t> content; // memory images only, the hash alone cannot guarantee it is the same image
+				std::size_t aliases = 0;
+			};
+
+		private:
+			std::unordered_map<std::string, Entry> _entries;
+			std::unordered_map<const Texture*, std::string> _aliases;
+			bool _enabled = false;
+	};
+}
+
+#endif
@@ -0,0 +1,250 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   job_system.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 03:01:14 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/19 04:39:38 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <core/job_system.h>
+#include <core/profiler.h>
+#include <chrono>
+#include <algorithm>
+#include <cstdint>
+
+namespace mlx
+{
+	static thread_local std::size_t __worker_index = SIZE_MAX;
+
+	void JobSystem::init(std::size_t workers_count)
+	{
+		MLX_PROFILE_FUNCTION();
+		if(_is_init)
+			return;
+		if(workers_count > 256) // hardware_concurrency() may return 0 when it cannot tell
+			workers_count = 0;
+		_main_thread = std::this_thread::get_id();
+		_should_stop = false;
+		for(std::size_t i = 0; i < workers_count + 1; i++)
+			_queues.push_back(std::make_unique<WorkQueue>());
+		for(std::size_t i = 0; i < workers_count; i++)
+			_workers.emplace_back(&JobSystem::workerLoop, this, i);
+		_is_init = true;
+	}
+
+	JobHandle JobSystem::submit(std::function<void()> task)
+	{
+		JobHandle job = std::make_shared<Job>();
+		job->task = std::move(task);
+		schedule(job);
+		return job;
+	}
+
+	JobHandle JobSystem::then(const JobHandle& job, std::function<void()> continuation, bool on_main_thread)
+	{
+		JobHandle next = std::make_shared<Job>();
+		next->task = std::move(continuation);
+		next->on_main_thread = on_main_thread;
+		{
+			std::unique_lock<std::mutex> lock(job->mutex);
+			if(!job->done)
+			{
+				job->continuations.push_back(next);
+				return next;
+			}
+		}
+		schedule(next);
+		return next;
+	}
+
+	void JobSystem::parallelFor(std::size_t jobs_count, const std::function<void(std::size_t)>& job)
+	{
+		MLX_PROFILE_FUNCTION();
+		if(jobs_count == 0)
+			return;
+		// contiguous ranges keep neighbouring jobs on the same thread, having more ranges than threads lets stealing even out the rest
+		std::size_t ranges_count = std::min(jobs_count, (_workers.size() + 1) * 4);
+		std::size_t range_size = (jobs_count + ranges_count - 1) / ranges_count;
+		std::vector<JobHandle> ranges;
+		ranges.reserve(ranges_count);
+		for(std::size_t begin = 0; begin < jobs_count; begin += range_size)
+		{
+			std::size_t end = std::min(jobs_count, begin + range_size);
+			ranges.push_back(submit([&job, begin, end]()
+			{
+				for(std::size_t i = begin; i < end; i++)
+					job(i);
+			}));
+		}
+
+		// unlike wait(), never runs the main thread jobs, the caller is in the middle of its own work
+		std::size_t queue_index = (__worker_index < _queues.size() ? __worker_index : _queues.size() - 1);
+		for(const JobHandle& range : ranges)
+		{
+			while(!range->isDone())
+			{
+				if(!_queues.empty() && runOneJob(queue_index))
+					continue;
+				std::unique_lock<std::mutex> lock(range->mutex);
+				range->done_cv.wait_for(lock, std::chrono::milliseconds(1), [&]() { return range->done; });
+			}
+		}
+	}
+
+	void JobSystem::schedule(JobHandle job)
+	{
+		if(job->on_main_thread)
+		{
+			{
+				std::unique_lock<std::mutex> lock(_main_thread_mutex);
+				_main_thread_jobs.push_back(std::move(job));
+			}
+			if(_main_thread_notifier)
+				_main_thread_notifier();
+			return;
+		}
+		if(_workers.empty()) // single core machine or not initialized yet
+		{
+			runJob(job);
+			return;
+		}
+		// counted before being pushed, a worker could otherwise steal it and decrement the counter first
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_queued_jobs++;
+		}
+		// workers keep their own jobs, other threads all share the last queue
+		WorkQueue& queue = *_queues[__worker_index < _queues.size() ? __worker_index : _queues.size() - 1];
+		{
+			std::unique_lock<std::mutex> lock(queue.mutex);
+			queue.jobs.push_front(std::move(job));
+		}
+		_work_cv.notify_one();
+	}
+
+	void JobSystem::runJob(const JobHandle& job)
+	{
+		if(job->task)
+			job->task();
+		std::vector<JobHandle> continuations;
+		{
+			std::unique_lock<std::mutex> lock(job->mutex);
+			job->task = nullptr; // releases what the task captured
+			job->done = true;
+			continuations.swap(job->continuations);
+		}
+		job->done_cv.notify_all();
+		for(JobHandle& continuation : continuations)
+			schedule(std::move(continuation));
+	}
+
+	bool JobSystem::runOneJob(std::size_t queue_index)
+	{
+		JobHandle job;
+		{
+			// the owner takes the most recent job, the one which data is the most likely to still be in cache
+			WorkQueue& queue = *_queues[queue_index];
+			std::unique_lock<std::mutex> lock(queue.mutex);
+			if(!queue.jobs.empty())
+			{
+				job = std::move(queue.jobs.front());
+				queue.jobs.pop_front();
+			}
+		}
+		for(std::size_t i = 1; job == nullptr && i < _queues.size(); i++)
+		{
+			// steals the oldest one
+			WorkQueue& victim = *_queues[(queue_index + i) % _queues.size()];
+			std::unique_lock<std::mutex> lock(victim.mutex);
+			if(!victim.jobs.empty())
+			{
+				job = std::move(victim.jobs.back());
+				victim.jobs.pop_back();
+			}
+		}
+		if(job == nullptr)
+			return false;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_queued_jobs--;
+		}
+		runJob(job);
+		return true;
+	}
+
+	void JobSystem::workerLoop(std::size_t queue_index)
+	{
+		__worker_index = queue_index;
+		for(;;)
+		{
+			{
+				std::unique_lock<std::mutex> lock(_mutex);
+				_work_cv.wait(lock, [this]() { return _should_stop || _queued_jobs != 0; });
+				if(_should_stop && _queued_jobs == 0)
+					return;
+			}
+			while(runOneJob(queue_index));
+		}
+	}
+
+	void JobSystem::wait(const JobHandle& job)
+	{
+		MLX_PROFILE_FUNCTION();
+		if(job == nullptr)
+			return;
+		std::size_t queue_index = (__worker_index < _queues.size() ? __worker_index : _queues.size() - 1);
+		while(!job->isDone())
+		{
+			if(isMainThread())
+				pumpMainThreadJobs();
+			if(!_queues.empty() && runOneJob(queue_index))
+				continue;
+			// the job is running somewhere else, or is a main thread one if we are not the main thread
+			std::unique_lock<std::mutex> lock(job->mutex);
+			job->done_cv.wait_for(lock, std::chrono::milliseconds(1), [&]() { return job->done; });
+		}
+	}
+
+	void JobSystem::pumpMainThreadJobs()
+	{
+		MLX_PROFILE_FUNCTION();
+		std::deque<JobHandle> jobs;
+		{
+			std::unique_lock<std::mutex> lock(_main_thread_mutex);
+			jobs.swap(_main_thread_jobs);
+		}
+		for(JobHandle& job : jobs)
+			runJob(job);
+	}
+
+	void JobSystem::destroy()
+	{
+		MLX_PROFILE_FUNCTION();
+		if(!_is_init)
+			return;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_should_stop = true;
+		}
+		_work_cv.notify_all();
+		for(std::thread& worker : _workers)
+			worker.join();
+		_workers.clear();
+		_queues.clear();
+		{
+			std::unique_lock<std::mutex> lock(_main_thread_mutex);
+			_main_thread_jobs.clear();
+		}
+		_main_thread_notifier = nullptr;
+		_is_init = false;
+	}
+
+	JobSystem::~JobSystem()
+	{
+		destroy();
+	}
+}
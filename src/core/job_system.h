@@ -0,0 +1,131 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   job_system.h                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 03:00:30 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/19 04:21:09 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef __MLX_JOB_SYSTEM__
+#define __MLX_JOB_SYSTEM__
+
+#include <mlx_profile.h>
+#include <deque>
+#include <mutex>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <optional>
+#include <functional>
+#include <type_traits>
+#include <condition_variable>
+
+#include <utils/singleton.h>
+
+namespace mlx
+{
+	struct Job : public NonCopyable
+	{
+		std::function<void()> task;
+		std::vector<std::shared_ptr<Job>> continuations; // scheduled once the task is done
+		std::mutex mutex;
+		std::condition_variable done_cv;
+		bool on_main_thread = false;
+		bool done = false;
+
+		inline bool isDone() { std::unique_lock<std::mutex> lock(mutex); return done; }
+	};
+
+	using JobHandle = std::shared_ptr<Job>;
+
+	template <typename T>
+	class JobFuture
+	{
+		public:
+			JobFuture() = default;
+			JobFuture(JobHandle job, std::shared_ptr<std::optional<T>> result) : _job(std::move(job)), _result(std::move(result)) {}
+
+			inline bool isValid() const noexcept { return _job != nullptr; }
+			inline bool isReady() const { return _job != nullptr && _job->isDone(); }
+			inline const JobHandle& getJob() const noexcept { return _job; }
+			inline T& get(); // waits for the job, helping with the other ones meanwhile
+
+		private:
+			JobHandle _job;
+			std::shared_ptr<std::optional<T>> _result;
+	};
+
+	class JobSystem : public Singleton<JobSystem>
+	{
+		friend class Singleton<JobSystem>;
+
+		public:
+			void init(std::size_t workers_count = std::thread::hardware_concurrency() - 1); // the calling thread becomes the main thread
+			inline void setMainThreadNotifier(std::function<void()> notifier) { _main_thread_notifier = std::move(notifier); }
+
+			JobHandle submit(std::function<void()> task);
+			JobHandle then(const JobHandle& job, std::function<void()> continuation, bool on_main_thread = false);
+			template <typename F>
+			inline JobFuture<std::invoke_result_t<F>> async(F&& task);
+			void parallelFor(std::size_t jobs_count, const std::function<void(std::size_t)>& job); // the calling thread takes part in the work until every job is done
+
+			void wait(const JobHandle& job); // runs other jobs while waiting, and the main thread ones when called from the main thread
+			void pumpMainThreadJobs(); // runs the continuations queued for the main thread
+			void destroy(); // waits for the queued jobs, main thread ones are dropped
+
+			inline bool isInit() const noexcept { return _is_init; }
+			inline bool isMainThread() const noexcept { return std::this_thread::get_id() == _main_thread; }
+			inline std::size_t getThreadsCount() const noexcept { return _workers.size(); }
+
+		private:
+			struct WorkQueue
+			{
+				std::deque<JobHandle> jobs;
+				std::mutex mutex;
+			};
+
+		private:
+			JobSystem() = default;
+			~JobSystem();
+
+			void schedule(JobHandle job);
+			void runJob(const JobHandle& job);
+			bool runOneJob(std::size_t queue_index); // pops from its own queue first then steals from the others
+			void workerLoop(std::size_t queue_index);
+
+		private:
+			std::vector<std::thread> _workers;
+			std::vector<std::unique_ptr<WorkQueue>> _queues; // one per worker, the last one receives the jobs submitted by other threads
+			std::deque<JobHandle> _main_thread_jobs;
+			std::function<void()> _main_thread_notifier;
+			std::mutex _main_thread_mutex;
+			std::mutex _mutex;
+			std::condition_variable _work_cv;
+			std::thread::id _main_thread;
+			std::size_t _queued_jobs = 0;
+			bool _should_stop = false;
+			bool _is_init = false;
+	};
+
+	template <typename T>
+	T& JobFuture<T>::get()
+	{
+		JobSystem::get().wait(_job);
+		return **_result;
+	}
+
+	template <typename F>
+	JobFuture<std::invoke_result_t<F>> JobSystem::async(F&& task)
+	{
+		using T = std::invoke_result_t<F>;
+		auto result = std::make_shared<std::optional<T>>();
+		JobHandle job = submit([result, task = std::forward<F>(task)]() mutable { result->emplace(task()); });
+		return JobFuture<T>(std::move(job), std::move(result));
+	}
+}
+
+#endif
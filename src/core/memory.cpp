@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/12/07 16:32:01 by kbz_8             #+#    #+#             */
-/*   Updated: 2023/12/11 15:25:02 by kbz_8            ###   ########.fr       */
+/*   Updated: 2026/10/19 02:55:39 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -18,6 +18,7 @@ namespace mlx
 {
 	void* MemManager::malloc(std::size_t size)
 	{
+		std::unique_lock<std::mutex> lock(_mutex);
 		void* ptr = std::malloc(size);
 		if(ptr != nullptr)
 			_blocks.push_back(ptr);
@@ -26,6 +27,7 @@ namespace mlx
 
 	void* MemManager::calloc(std::size_t n, std::size_t size)
 	{
+		std::unique_lock<std::mutex> lock(_mutex);
 		void* ptr = std::calloc(n, size);
 		if(ptr != nullptr)
 			_blocks.push_back(ptr);
@@ -34,6 +36,7 @@ namespace mlx
 
 	void* MemManager::realloc(void* ptr, std::size_t size)
 	{
+		std::unique_lock<std::mutex> lock(_mutex);
 		void* ptr2 = std::realloc(ptr, size);
 		if(ptr2 != nullptr)
 			_blocks.push_back(ptr2);
@@ -45,6 +48,7 @@ namespace mlx
 
 	void MemManager::free(void* ptr)
 	{
+		std::unique_lock<std::mutex> lock(_mutex);
 		auto it = std::find(_blocks.begin(), _blocks.end(), ptr);
 		if(it == _blocks.end())
 		{
@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/12/07 16:31:51 by kbz_8             #+#    #+#             */
-/*   Updated: 2023/12/11 19:47:13 by kbz_8            ###   ########.fr       */
+/*   Updated: 2026/10/19 02:55:39 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -16,6 +16,7 @@
 #include <utils/singleton.h>
 #include <mlx_profile.h>
 #include <list>
+#include <mutex>
 
 namespace mlx
 {
@@ -35,6 +36,7 @@ namespace mlx
 
 		private:
 			inline static std::list<void*> _blocks;
+			inline static std::mutex _mutex; // SDL and stb may allocate from the render thread
 	};
 }
 
@@ -0,0 +1,145 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   put_queues.cpp                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 02:56:10 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/19 04:20:23 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <core/put_queues.h>
+#include <core/profiler.h>
+#include <algorithm>
+#include <iterator>
+
+namespace mlx
+{
+	PutQueues::PutQueues() : _registry(std::make_shared<Registry>()), _instance_id(++_instances_count) {}
+
+	void PutQueues::ThreadQueue::retire()
+	{
+		std::shared_ptr<Registry> owner = registry.lock();
+		if(!owner)
+			return;
+		// the queue may still hold puts of this frame, the merge drops it once they are taken
+		std::unique_lock<std::mutex> lock(queue->mutex);
+		queue->retired = true;
+		registry.reset();
+	}
+
+	PutQueues::Queue& PutQueues::getThreadQueue()
+	{
+		thread_local ThreadQueue cached;
+		if(cached.instance_id == _instance_id)
+			return *cached.queue;
+
+		cached.retire(); // the thread moved to another application
+		std::unique_lock<std::mutex> lock(_registry->mutex);
+		_registry->queues.push_back(std::make_unique<Queue>());
+		cached.registry = _registry;
+		cached.queue = _registry->queues.back().get();
+		cached.instance_id = _instance_id;
+		return *cached.queue;
+	}
+
+	void PutQueues::record(const RenderCommand& command, const char* str, const ImageTransform* transform, const std::vector<Vertex>* shape)
+	{
+		Queue& queue = getThreadQueue();
+		std::unique_lock<std::mutex> lock(queue.mutex);
+		if(shape != nullptr)
+		{
+			queue.packet.pushShape(command, *shape);
+			return;
+		}
+		RenderCommand& recorded = queue.packet.commands.emplace_back(command);
+		if(str != nullptr)
+		{
+			recorded.string = static_cast<std::uint32_t>(queue.packet.strings.size());
+			queue.packet.strings.emplace_back(str);
+		}
+		if(transform != nullptr)
+		{
+			recorded.transform = static_cast<std::uint32_t>(queue.packet.transforms.size());
+			queue.packet.transforms.push_back(*transform);
+		}
+	}
+
+	void PutQueues::setOrderKey(int key)
+	{
+		Queue& queue = getThreadQueue();
+		std::unique_lock<std::mutex> lock(queue.mutex);
+		queue.key = key;
+	}
+
+	void PutQueues::merge(FramePacket& packet)
+	{
+		MLX_PROFILE_FUNCTION();
+		struct Entry
+		{
+			Queue* queue;
+			int key;
+			bool retired;
+		};
+		std::vector<Entry> queues;
+		{
+			// only the main thread removes queues, they stay alive until the end of the merge
+			std::unique_lock<std::mutex> lock(_registry->mutex);
+			queues.reserve(_registry->queues.size());
+			for(auto& queue : _registry->queues)
+			{
+				std::unique_lock<std::mutex> queue_lock(queue->mutex);
+				queues.push_back({ queue.get(), queue->key, queue->retired });
+			}
+		}
+		// stable so queues sharing a key keep their registration order
+		std::stable_sort(queues.begin(), queues.end(), [](const Entry& a, const Entry& b) { return a.key < b.key; });
+
+		bool has_retired = false;
+		for(const Entry& entry : queues)
+		{
+			Queue* queue = entry.queue;
+			has_retired = has_retired || entry.retired;
+			std::unique_lock<std::mutex> lock(queue->mutex);
+			std::uint32_t strings_offset = static_cast<std::uint32_t>(packet.strings.size());
+			std::uint32_t transforms_offset = static_cast<std::uint32_t>(packet.transforms.size());
+			std::uint32_t vertices_offset = static_cast<std::uint32_t>(packet.vertices.size());
+			for(RenderCommand command : queue->packet.commands)
+			{
+				command.string += strings_offset;
+				command.vertices += vertices_offset;
+				if(command.transform != RenderCommand::NO_TRANSFORM)
+					command.transform += transforms_offset;
+				packet.commands.push_back(command);
+			}
+			std::move(queue->packet.strings.begin(), queue->packet.strings.end(), std::back_inserter(packet.strings));
+			packet.transforms.insert(packet.transforms.end(), queue->packet.transforms.begin(), queue->packet.transforms.end());
+			packet.vertices.insert(packet.vertices.end(), queue->packet.vertices.begin(), queue->packet.vertices.end());
+			queue->packet.clear();
+		}
+
+		if(!has_retired)
+			return;
+		// retired before being merged, nothing can be put in them anymore
+		std::unique_lock<std::mutex> lock(_registry->mutex);
+		auto& registered = _registry->queues;
+		registered.erase(std::remove_if(registered.begin(), registered.end(), [&](const std::unique_ptr<Queue>& queue)
+		{
+			return std::any_of(queues.begin(), queues.end(), [&](const Entry& entry) { return entry.retired && entry.queue == queue.get(); });
+		}), registered.end());
+	}
+
+	void PutQueues::eraseCommands(const std::function<bool(const RenderCommand&)>& predicate)
+	{
+		MLX_PROFILE_FUNCTION();
+		std::unique_lock<std::mutex> lock(_registry->mutex);
+		for(auto& queue : _registry->queues)
+		{
+			std::unique_lock<std::mutex> queue_lock(queue->mutex);
+			auto& commands = queue->packet.commands;
+			commands.erase(std::remove_if(commands.begin(), commands.end(), predicate), commands.end());
+		}
+	}
+}
@@ -0,0 +1,77 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   put_queues.h                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 02:56:10 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/19 04:20:23 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef __MLX_PUT_QUEUES__
+#define __MLX_PUT_QUEUES__
+
+#include <mlx_profile.h>
+#include <mutex>
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <functional>
+
+#include <core/render_thread.h>
+#include <utils/non_copyable.h>
+
+namespace mlx
+{
+	// puts issued by threads other than the main one, each thread records in its own queue
+	class PutQueues : public NonCopyable
+	{
+		public:
+			PutQueues();
+
+			void record(const RenderCommand& command, const char* str = nullptr, const ImageTransform* transform = nullptr, const std::vector<Vertex>* shape = nullptr); // may be called from any thread
+			void setOrderKey(int key); // ordering key of the calling thread queue
+			void merge(FramePacket& packet); // appends queued commands ordered by key, then by thread registration, then by call order
+			void eraseCommands(const std::function<bool(const RenderCommand&)>& predicate); // drops the queued commands matching the predicate
+
+			~PutQueues() = default;
+
+		private:
+			struct Queue
+			{
+				FramePacket packet;
+				std::mutex mutex;
+				int key = 0;
+				bool retired = false; // its thread has exited, dropped once merged
+			};
+
+			struct Registry
+			{
+				std::vector<std::unique_ptr<Queue>> queues; // in registration order
+				std::mutex mutex;
+			};
+
+			struct ThreadQueue // thread local, retires the queue when its thread exits
+			{
+				std::weak_ptr<Registry> registry;
+				Queue* queue = nullptr;
+				std::uint64_t instance_id = 0; // avoids reusing a queue of a destroyed application living at the same address
+
+				void retire();
+				~ThreadQueue() { retire(); }
+			};
+
+		private:
+			Queue& getThreadQueue();
+
+		private:
+			std::shared_ptr<Registry> _registry; // shared with the threads so they can retire their queue after the application is gone
+			std::uint64_t _instance_id;
+			inline static std::atomic<std::uint64_t> _instances_count = 0;
+	};
+}
+
+#endif
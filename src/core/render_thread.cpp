@@ -0,0 +1,89 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   render_thread.cpp                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 02:54:28 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/19 02:55:39 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <core/render_thread.h>
+#include <core/profiler.h>
+
+namespace mlx
+{
+	void RenderThread::start(std::function<bool(FramePacket&)> render)
+	{
+		MLX_PROFILE_FUNCTION();
+		if(isRunning())
+			return;
+		_render = std::move(render);
+		_should_stop = false;
+		_has_pending_packet = false;
+		_has_rendered = false;
+		_thread = std::thread(&RenderThread::renderLoop, this);
+	}
+
+	bool RenderThread::submitFrame()
+	{
+		MLX_PROFILE_FUNCTION();
+		std::unique_lock<std::mutex> lock(_mutex);
+		_cv.wait(lock, [this]() { return !_has_pending_packet; });
+		bool has_rendered = _has_rendered;
+		_recording_packet = (_recording_packet + 1) % _packets.size();
+		_packets[_recording_packet].clear();
+		_has_pending_packet = true;
+		lock.unlock();
+		_cv.notify_all();
+		return has_rendered;
+	}
+
+	void RenderThread::sync()
+	{
+		MLX_PROFILE_FUNCTION();
+		std::unique_lock<std::mutex> lock(_mutex);
+		_cv.wait(lock, [this]() { return !_has_pending_packet; });
+	}
+
+	void RenderThread::renderLoop()
+	{
+		for(;;)
+		{
+			{
+				std::unique_lock<std::mutex> lock(_mutex);
+				_cv.wait(lock, [this]() { return _should_stop || _has_pending_packet; });
+				if(!_has_pending_packet) // only stops once the last packet has been rendered
+					return;
+			}
+			// the main thread only records in the other packet until this one is marked as done
+			bool has_rendered = _render(_packets[(_recording_packet + 1) % _packets.size()]);
+			{
+				std::unique_lock<std::mutex> lock(_mutex);
+				_has_pending_packet = false;
+				_has_rendered = has_rendered;
+			}
+			_cv.notify_all();
+		}
+	}
+
+	void RenderThread::stop()
+	{
+		MLX_PROFILE_FUNCTION();
+		if(!isRunning())
+			return;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_should_stop = true;
+		}
+		_cv.notify_all();
+		_thread.join();
+	}
+
+	RenderThread::~RenderThread()
+	{
+		stop();
+	}
+}
@@ -0,0 +1,123 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   render_thread.h                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 02:54:28 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/19 04:24:43 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef __MLX_RENDER_THREAD__
+#define __MLX_RENDER_THREAD__
+
+#include <mlx_profile.h>
+#include <volk.h>
+#include <array>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <cstdint>
+#include <functional>
+#include <condition_variable>
+
+#include <utils/non_copyable.h>
+#include <renderer/images/image_transform.h>
+#include <renderer/renderer.h>
+
+namespace mlx
+{
+	struct RenderCommand
+	{
+		enum class kind : std::uint8_t
+		{
+			pixel_put = 0,
+			scroll_pixels,
+			layer_pixel_put,
+			layer_clear,
+			string_put,
+			texture_put,
+			tilemap_put,
+			shape_put,
+			clear,
+			load_font,
+			require_redraw,
+			set_view,
+			set_drawable_size,
+		};
+
+		class Texture* texture; // texture_put only
+		class Tilemap* tilemap; // tilemap_put only
+		struct PixelLayer* layer; // layer_pixel_put and layer_clear only
+		VkRect2D region; // texture_put: empty to put the whole texture, tilemap_put: size of the drawn area in the extent, shape_put: vertices count in the extent width, set_drawable_size: size in the extent
+		std::uint32_t color;
+		std::uint32_t string; // index in the packet strings, string_put and load_font only
+		std::uint32_t transform; // index in the packet transforms or NO_TRANSFORM, texture_put only
+		std::uint32_t vertices; // index of the first vertex in the packet vertices, shape_put only
+		float scale; // load_font: font scale, set_view: zoom
+		int window;
+		int x;
+		int y;
+		kind type;
+
+		static constexpr std::uint32_t NO_TRANSFORM = UINT32_MAX;
+	};
+
+	struct FramePacket
+	{
+		std::vector<RenderCommand> commands;
+		std::vector<std::string> strings;
+		std::vector<ImageTransform> transforms;
+		std::vector<Vertex> vertices; // triangles of the shapes
+
+		inline void pushShape(RenderCommand command, const std::vector<Vertex>& shape) // consecutive shapes of a window share a command
+		{
+			RenderCommand* last = (commands.empty() ? nullptr : &commands.back());
+			if(last != nullptr && last->type == RenderCommand::kind::shape_put && last->window == command.window && last->vertices + last->region.extent.width == vertices.size())
+				last->region.extent.width += static_cast<std::uint32_t>(shape.size());
+			else
+			{
+				command.vertices = static_cast<std::uint32_t>(vertices.size());
+				command.region.extent.width = static_cast<std::uint32_t>(shape.size());
+				commands.push_back(command);
+			}
+			vertices.insert(vertices.end(), shape.begin(), shape.end());
+		}
+		inline void clear() noexcept { commands.clear(); strings.clear(); transforms.clear(); vertices.clear(); }
+	};
+
+	class RenderThread : public NonCopyable
+	{
+		public:
+			RenderThread() = default;
+
+			void start(std::function<bool(FramePacket&)> render); // `render` replays a packet and returns true if a frame has been rendered
+			bool submitFrame(); // hands over the recorded packet, returns true if the previous one has produced a frame
+			void sync(); // waits for the render thread to be done with the packet it is working on
+			void stop();
+
+			inline bool isRunning() const noexcept { return _thread.joinable(); }
+			inline FramePacket& getRecordingPacket() noexcept { return _packets[_recording_packet]; }
+
+			~RenderThread();
+
+		private:
+			void renderLoop();
+
+		private:
+			std::array<FramePacket, 2> _packets;
+			std::function<bool(FramePacket&)> _render;
+			std::thread _thread;
+			std::mutex _mutex;
+			std::condition_variable _cv;
+			std::size_t _recording_packet = 0;
+			bool _has_pending_packet = false;
+			bool _has_rendered = false;
+			bool _should_stop = false;
+	};
+}
+
+#endif
@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/10/05 16:30:19 by maldavid          #+#    #+#             */
-/*   Updated: 2024/02/23 22:27:30 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 02:48:39 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -21,6 +21,7 @@ namespace mlx
 		MLX_PROFILE_FUNCTION();
 		_xRel = 0;
 		_yRel = 0;
+		_windows_with_events.clear();
 
 		while(SDL_PollEvent(&_event))
 		{
@@ -87,6 +88,7 @@ namespace mlx
 
 				case SDL_WINDOWEVENT:
 				{
+					_windows_with_events.insert(id);
 					auto& win_hook = hooks[MLX_WINDOW_EVENT];
 					switch(_event.window.event)
 					{
@@ -148,4 +150,10 @@ namespace mlx
 			}
 		}
 	}
+
+	void Input::waitEvent(std::uint32_t timeout_ms)
+	{
+		MLX_PROFILE_FUNCTION();
+		SDL_WaitEventTimeout(nullptr, static_cast<int>(timeout_ms));
+	}
 }
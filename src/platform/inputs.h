@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/10/05 16:27:35 by maldavid          #+#    #+#             */
-/*   Updated: 2024/04/22 17:35:23 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 02:48:39 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -16,6 +16,7 @@
 #include <function.h>
 #include <SDL2/SDL.h>
 #include <unordered_map>
+#include <unordered_set>
 
 #include <mlx_profile.h>
 
@@ -35,6 +36,7 @@ namespace mlx
 			Input() = default;
 
 			void update();
+			void waitEvent(std::uint32_t timeout_ms); // blocks until an event is available or the timeout expires
 
 			inline bool isMouseMoving() const noexcept { return _xRel || _yRel; }
 
@@ -44,6 +46,8 @@ namespace mlx
 			inline int getXRel() const noexcept { return _xRel; }
 			inline int getYRel() const noexcept { return _yRel; }
 
+			inline bool hasWindowEvent(std::uint32_t id) const noexcept { return _windows_with_events.count(id); }
+
 			inline bool isRunning() const noexcept { return !_end; }
 			inline constexpr void run() noexcept { _end = false; }
 			inline constexpr void finish() noexcept { _end = true; }
@@ -65,6 +69,7 @@ namespace mlx
 		private:
 			std::unordered_map<std::uint32_t, std::shared_ptr<MLX_Window>> _windows;
 			std::unordered_map<std::uint32_t, std::array<Hook, 6>> _events_hooks;
+			std::unordered_set<std::uint32_t> _windows_with_events;
 			SDL_Event _event;
 
 			int _x = 0;
@@ -6,12 +6,13 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/10/04 17:36:44 by maldavid          #+#    #+#             */
-/*   Updated: 2024/10/27 00:31:39 by kiroussa         ###   ########.fr       */
+/*   Updated: 2026/10/19 04:24:43 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include <platform/window.h>
 #include <core/errors.h>
+#include <SDL2/SDL_vulkan.h>
 #include <utils/icon_mlx.h>
 
 #ifndef MLX_WINDOW_CREATE_FLAGS
@@ -44,6 +45,11 @@ namespace mlx
 		SDL_SetWindowIcon(_win, _icon);
 	}
 
+	void MLX_Window::getDrawableSize(int& w, int& h) const noexcept
+	{
+		SDL_Vulkan_GetDrawableSize(_win, &w, &h);
+	}
+
 	void MLX_Window::destroy() noexcept
 	{
 		if(_win != nullptr)
@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/10/04 21:53:12 by maldavid          #+#    #+#             */
-/*   Updated: 2023/12/21 00:24:26 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 04:24:43 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -28,6 +28,7 @@ namespace mlx
 			inline int getWidth() const noexcept { return _width; }
 			inline int getHeight() const noexcept { return _height; }
 			inline std::uint32_t getID() const noexcept { return _id; }
+			void getDrawableSize(int& w, int& h) const noexcept; // main thread only
 
 			void destroy() noexcept;
 
@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/10/08 18:55:57 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/14 17:28:35 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 03:07:50 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -35,7 +35,10 @@ namespace mlx
 		}
 
 		VmaAllocationCreateInfo alloc_info{};
-		alloc_info.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
+		if(type == Buffer::kind::readback || type == Buffer::kind::staging) // these buffers are read by the CPU so we want them in cached memory
+			alloc_info.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_RANDOM_BIT;
+		else
+			alloc_info.flags = VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT;
 		alloc_info.usage = VMA_MEMORY_USAGE_AUTO;
 
 		createBuffer(_usage, alloc_info, size, name);
@@ -164,4 +167,9 @@ namespace mlx
 	{
 		Render_Core::get().getAllocator().flush(_allocation, size, offset);
 	}
+
+	void Buffer::invalidate(VkDeviceSize size, VkDeviceSize offset)
+	{
+		Render_Core::get().getAllocator().invalidate(_allocation, size, offset);
+	}
 }
@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/10/06 18:45:52 by maldavid          #+#    #+#             */
-/*   Updated: 2024/01/10 18:30:57 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 02:45:08 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -21,8 +21,10 @@ namespace mlx
 	{
 		MLX_PROFILE_FUNCTION();
 		_renderer = renderer;
+		_buffers.resize(renderer->getFramesInFlight());
+		_maps.resize(renderer->getFramesInFlight(), nullptr);
 
-		for(int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+		for(std::size_t i = 0; i < _buffers.size(); i++)
 		{
 			#ifdef DEBUG
 				std::string name_frame = name;
@@ -72,7 +74,9 @@ namespace mlx
 
 	void UBO::destroy() noexcept
 	{
-		for(int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
-			_buffers[i].destroy();
+		for(Buffer& buffer : _buffers)
+			buffer.destroy();
+		_buffers.clear();
+		_maps.clear();
 	}
 }
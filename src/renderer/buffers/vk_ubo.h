@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/10/06 18:45:29 by maldavid          #+#    #+#             */
-/*   Updated: 2023/12/08 19:06:28 by kbz_8            ###   ########.fr       */
+/*   Updated: 2026/10/19 02:45:08 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -14,7 +14,7 @@
 #define __MLX_VK_UBO__
 
 #include "vk_buffer.h"
-#include <array>
+#include <vector>
 #include <cstddef>
 #include <mlx_profile.h>
 
@@ -42,8 +42,8 @@ namespace mlx
 			inline VkBuffer& get(int i) noexcept { return _buffers[i].get(); }
 
 		private:
-			std::array<Buffer, MAX_FRAMES_IN_FLIGHT> _buffers;
-			std::array<void*, MAX_FRAMES_IN_FLIGHT> _maps;
+			std::vector<Buffer> _buffers;
+			std::vector<void*> _maps;
 			class Renderer* _renderer = nullptr;
 	};
 }
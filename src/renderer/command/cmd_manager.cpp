@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/04/02 17:50:52 by maldavid          #+#    #+#             */
-/*   Updated: 2023/12/17 20:10:45 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 02:45:08 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -14,11 +14,12 @@
 
 namespace mlx
 {
-	void CmdManager::init() noexcept
+	void CmdManager::init(std::uint32_t frames_in_flight) noexcept
 	{
 		_cmd_pool.init();
-		for(int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
-			_cmd_buffers[i].init(CmdBuffer::kind::long_time, this);
+		_cmd_buffers = std::vector<CmdBuffer>(frames_in_flight);
+		for(CmdBuffer& cmd : _cmd_buffers)
+			cmd.init(CmdBuffer::kind::long_time, this);
 	}
 
 	void CmdManager::beginRecord(int active_image_index)
@@ -33,8 +34,9 @@ namespace mlx
 
 	void CmdManager::destroy() noexcept
 	{
-		for(int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
-			_cmd_buffers[i].destroy();
+		for(CmdBuffer& cmd : _cmd_buffers)
+			cmd.destroy();
+		_cmd_buffers.clear();
 		_cmd_pool.destroy();
 	}
 }
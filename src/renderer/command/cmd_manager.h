@@ -6,14 +6,14 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/04/02 17:48:52 by maldavid          #+#    #+#             */
-/*   Updated: 2024/01/03 15:27:35 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 02:45:08 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #ifndef __MLX_COMMAND_MANAGER__
 #define __MLX_COMMAND_MANAGER__
 
-#include <array>
+#include <vector>
 
 #include <mlx_profile.h>
 #include <volk.h>
@@ -28,7 +28,7 @@ namespace mlx
 		public:
 			CmdManager() = default;
 
-			void init() noexcept;
+			void init(std::uint32_t frames_in_flight) noexcept;
 			void beginRecord(int active_image_index);
 			void endRecord(int active_image_index);
 			void destroy() noexcept;
@@ -39,7 +39,7 @@ namespace mlx
 			~CmdManager() = default;
 
 		private:
-			std::array<CmdBuffer, MAX_FRAMES_IN_FLIGHT> _cmd_buffers;
+			std::vector<CmdBuffer> _cmd_buffers;
 			CmdPool _cmd_pool;
 	};
 }
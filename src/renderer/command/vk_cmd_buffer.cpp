@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/10/06 18:26:06 by maldavid          #+#    #+#             */
-/*   Updated: 2024/02/25 08:02:26 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 03:59:12 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -152,7 +152,7 @@ namespace mlx
 		region.imageSubresource.mipLevel = 0;
 		region.imageSubresource.baseArrayLayer = 0;
 		region.imageSubresource.layerCount = 1;
-		region.imageOffset = { 0, 0, 0 };
+		region.imageOffset = { image.getOffset().x, image.getOffset().y, 0 };
 		region.imageExtent = { image.getWidth(), image.getHeight(), 1 };
 
 		vkCmdCopyBufferToImage(_cmd_buffer, buffer.get(), image.get(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
@@ -165,6 +165,27 @@ namespace mlx
 		vector_push_back_if_not_found(_cmd_resources, &buffer);
 	}
 
+	void CmdBuffer::copyBufferToImage(Buffer& buffer, Image& image, const std::vector<VkBufferImageCopy>& regions) noexcept
+	{
+		MLX_PROFILE_FUNCTION();
+		if(!isRecording())
+		{
+			core::error::report(e_kind::warning, "Vulkan : trying to do a buffer to image copy in a non recording command buffer");
+			return;
+		}
+
+		preTransferBarrier();
+
+		vkCmdCopyBufferToImage(_cmd_buffer, buffer.get(), image.get(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, static_cast<std::uint32_t>(regions.size()), regions.data());
+
+		postTransferBarrier();
+
+		image.recordedInCmdBuffer();
+		buffer.recordedInCmdBuffer();
+		vector_push_back_if_not_found(_cmd_resources, &image);
+		vector_push_back_if_not_found(_cmd_resources, &buffer);
+	}
+
 	void CmdBuffer::copyImagetoBuffer(Image& image, Buffer& buffer) noexcept
 	{
 		MLX_PROFILE_FUNCTION();
@@ -184,7 +205,7 @@ namespace mlx
 		region.imageSubresource.mipLevel = 0;
 		region.imageSubresource.baseArrayLayer = 0;
 		region.imageSubresource.layerCount = 1;
-		region.imageOffset = { 0, 0, 0 };
+		region.imageOffset = { image.getOffset().x, image.getOffset().y, 0 };
 		region.imageExtent = { image.getWidth(), image.getHeight(), 1 };
 
 		vkCmdCopyImageToBuffer(_cmd_buffer, image.get(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, buffer.get(), 1, &region);
@@ -197,6 +218,64 @@ namespace mlx
 		vector_push_back_if_not_found(_cmd_resources, &image);
 	}
 
+	void CmdBuffer::copyImageToImage(Image& src, Image& dst, VkRect2D area) noexcept
+	{
+		copyImageToImage(src, dst, area, area.offset);
+	}
+
+	void CmdBuffer::copyImageToImage(Image& src, Image& dst, VkRect2D area, VkOffset2D dst_offset) noexcept
+	{
+		MLX_PROFILE_FUNCTION();
+		if(!isRecording())
+		{
+			core::error::report(e_kind::warning, "Vulkan : trying to do an image to image copy in a non recording command buffer");
+			return;
+		}
+
+		VkImageCopy region{};
+		region.srcSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		region.srcSubresource.mipLevel = 0;
+		region.srcSubresource.baseArrayLayer = 0;
+		region.srcSubresource.layerCount = 1;
+		region.srcOffset = { area.offset.x, area.offset.y, 0 };
+		region.dstSubresource = region.srcSubresource;
+		region.dstOffset = { dst_offset.x, dst_offset.y, 0 };
+		region.extent = { area.extent.width, area.extent.height, 1 };
+
+		vkCmdCopyImage(_cmd_buffer, src.get(), VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, dst.get(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+		src.recordedInCmdBuffer();
+		dst.recordedInCmdBuffer();
+		vector_push_back_if_not_found(_cmd_resources, &src);
+		vector_push_back_if_not_found(_cmd_resources, &dst);
+	}
+
+	void CmdBuffer::clearColorImage(Image& image, VkClearColorValue color) noexcept
+	{
+		MLX_PROFILE_FUNCTION();
+		if(!isRecording())
+		{
+			core::error::report(e_kind::warning, "Vulkan : trying to clear an image in a non recording command buffer");
+			return;
+		}
+
+		preTransferBarrier();
+
+		VkImageSubresourceRange range{};
+		range.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		range.baseMipLevel = 0;
+		range.levelCount = 1;
+		range.baseArrayLayer = 0;
+		range.layerCount = 1;
+
+		vkCmdClearColorImage(_cmd_buffer, image.get(), VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &color, 1, &range);
+
+		postTransferBarrier();
+
+		image.recordedInCmdBuffer();
+		vector_push_back_if_not_found(_cmd_resources, &image);
+	}
+
 	void CmdBuffer::transitionImageLayout(Image& image, VkImageLayout new_layout) noexcept
 	{
 		MLX_PROFILE_FUNCTION();
@@ -283,7 +362,7 @@ namespace mlx
 			waitForExecution();
 	}
 
-	void CmdBuffer::submit(Semaphore* semaphores) noexcept
+	void CmdBuffer::submit(Semaphore* semaphores, VkPipelineStageFlags wait_stage) noexcept
 	{
 		MLX_PROFILE_FUNCTION();
 		std::array<VkSemaphore, 1> signalSemaphores;
@@ -299,7 +378,7 @@ namespace mlx
 			signalSemaphores[0] = VK_NULL_HANDLE;
 			waitSemaphores[0] = VK_NULL_HANDLE;
 		}
-		VkPipelineStageFlags waitStages[] = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
+		VkPipelineStageFlags waitStages[] = { wait_stage };
 
 		_fence.reset();
 
@@ -355,6 +434,18 @@ namespace mlx
 		vkCmdPipelineBarrier(_cmd_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_VERTEX_SHADER_BIT, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
 	}
 
+	void CmdBuffer::transferBarrier() noexcept
+	{
+		MLX_PROFILE_FUNCTION();
+		VkMemoryBarrier memoryBarrier{};
+		memoryBarrier.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		memoryBarrier.pNext = nullptr;
+		memoryBarrier.srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+		memoryBarrier.dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+
+		vkCmdPipelineBarrier(_cmd_buffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
+	}
+
 	void CmdBuffer::destroy() noexcept
 	{
 		MLX_PROFILE_FUNCTION();
@@ -6,7 +6,7 @@
 /*   By: bonsthie <bonsthie@42angouleme.fr>         +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/10/06 18:25:42 by maldavid          #+#    #+#             */
-/*   Updated: 2024/08/08 17:46:00 by bonsthie         ###   ########.fr       */
+/*   Updated: 2026/10/19 03:59:12 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -48,7 +48,7 @@ namespace mlx
 			void destroy() noexcept;
 
 			void beginRecord(VkCommandBufferUsageFlags usage = 0);
-			void submit(class Semaphore* semaphores) noexcept;
+			void submit(class Semaphore* semaphores, VkPipelineStageFlags wait_stage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT) noexcept;
 			void submitIdle(bool shouldWaitForExecution = true) noexcept; // TODO : handle `shouldWaitForExecution` as false by default (needs to modify CmdResources lifetimes to do so)
 			void updateSubmitState() noexcept;
 			inline void waitForExecution() noexcept { _fence.wait(); updateSubmitState(); _state = state::ready; }
@@ -59,7 +59,12 @@ namespace mlx
 			void bindIndexBuffer(Buffer& buffer) noexcept;
 			void copyBuffer(Buffer& dst, Buffer& src) noexcept;
 			void copyBufferToImage(Buffer& buffer, Image& image) noexcept;
+			void copyBufferToImage(Buffer& buffer, Image& image, const std::vector<VkBufferImageCopy>& regions) noexcept; // regions are not moved by the image offset
 			void copyImagetoBuffer(Image& image, Buffer& buffer) noexcept;
+			void copyImageToImage(Image& src, Image& dst, VkRect2D area) noexcept; // src and dst must already be in transfer layouts
+			void copyImageToImage(Image& src, Image& dst, VkRect2D area, VkOffset2D dst_offset) noexcept; // area of src is written at dst_offset in dst
+			void clearColorImage(Image& image, VkClearColorValue color) noexcept; // image must already be in transfer dst layout
+			void transferBarrier() noexcept; // orders transfers writing the same memory
 			void transitionImageLayout(Image& image, VkImageLayout new_layout) noexcept;
 
 			inline bool isInit() const noexcept { return _state != state::uninit; }
@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/01/10 21:00:37 by maldavid          #+#    #+#             */
-/*   Updated: 2024/01/11 01:21:15 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 02:53:36 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -16,6 +16,7 @@
 #include <mlx_profile.h>
 #include <volk.h>
 #include <array>
+#include <cstddef>
 
 namespace mlx
 {
@@ -25,6 +26,8 @@ namespace mlx
 			DrawableResource() = default;
 			virtual void render(std::array<VkDescriptorSet, 2>& sets, class Renderer& renderer) = 0;
 			virtual void resetUpdate() {}
+			virtual std::size_t getSignature() const noexcept = 0; // changes whenever what would be drawn changes
+			virtual VkRect2D getBounds() const noexcept = 0; // area of the render target covered by the resource
 			virtual ~DrawableResource() = default;
 	};
 }
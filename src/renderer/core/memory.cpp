@@ -6,7 +6,7 @@
 /*   By: kbz_8 <kbz_8.dev@akel-engine.com>          +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/10/20 22:02:37 by kbz_8             #+#    #+#             */
-/*   Updated: 2024/09/14 00:04:16 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 02:41:36 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -185,6 +185,12 @@ namespace mlx
 		vmaFlushAllocation(_allocator, allocation, offset, size);
 	}
 
+	void GPUallocator::invalidate(VmaAllocation allocation, VkDeviceSize size, VkDeviceSize offset) noexcept
+	{
+		MLX_PROFILE_FUNCTION();
+		vmaInvalidateAllocation(_allocator, allocation, offset, size);
+	}
+
 	void GPUallocator::destroy() noexcept
 	{
 		if(_active_images_allocations != 0)
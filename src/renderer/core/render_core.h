@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/10/08 19:16:32 by maldavid          #+#    #+#             */
-/*   Updated: 2024/01/20 08:17:58 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 02:45:08 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -46,7 +46,8 @@ namespace mlx
 
 	const std::vector<const char*> validationLayers = { "VK_LAYER_KHRONOS_validation" };
 
-	constexpr const int MAX_FRAMES_IN_FLIGHT = 3;
+	constexpr const int DEFAULT_FRAMES_IN_FLIGHT = 3;
+	constexpr const int MAX_FRAMES_IN_FLIGHT = 8; // upper bound of the frames in flight count that can be chosen at runtime
 	constexpr const int MAX_SETS_PER_POOL = 512;
 	constexpr const int NUMBER_OF_UNIFORM_BUFFERS = 1; // change this if for wathever reason more than one uniform buffer is needed
 
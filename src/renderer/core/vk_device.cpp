@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/10/08 19:14:29 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/14 17:23:45 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 02:53:36 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -15,6 +15,7 @@
 #include <map>
 #include <vector>
 #include <set>
+#include <cstring>
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_vulkan.h>
 
@@ -44,6 +45,11 @@ namespace mlx
 
 		VkPhysicalDeviceFeatures deviceFeatures{};
 
+		std::vector<const char*> extensions = deviceExtensions;
+		_supports_incremental_present = isExtensionSupported(_physical_device, VK_KHR_INCREMENTAL_PRESENT_EXTENSION_NAME);
+		if(_supports_incremental_present)
+			extensions.push_back(VK_KHR_INCREMENTAL_PRESENT_EXTENSION_NAME);
+
 		VkDeviceCreateInfo createInfo{};
 		createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
 
@@ -52,8 +58,8 @@ namespace mlx
 
 		createInfo.pEnabledFeatures = &deviceFeatures;
 
-		createInfo.enabledExtensionCount = static_cast<std::uint32_t>(deviceExtensions.size());
-		createInfo.ppEnabledExtensionNames = deviceExtensions.data();
+		createInfo.enabledExtensionCount = static_cast<std::uint32_t>(extensions.size());
+		createInfo.ppEnabledExtensionNames = extensions.data();
 		createInfo.enabledLayerCount = 0;
 
 		VkResult res;
@@ -156,6 +162,22 @@ namespace mlx
 		return requiredExtensions.empty();
 	}
 
+	bool Device::isExtensionSupported(VkPhysicalDevice device, const char* extension)
+	{
+		std::uint32_t extensionCount;
+		vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, nullptr);
+
+		std::vector<VkExtensionProperties> availableExtensions(extensionCount);
+		vkEnumerateDeviceExtensionProperties(device, nullptr, &extensionCount, availableExtensions.data());
+
+		for(const auto& available : availableExtensions)
+		{
+			if(std::strcmp(available.extensionName, extension) == 0)
+				return true;
+		}
+		return false;
+	}
+
 	void Device::destroy() noexcept
 	{
 		vkDestroyDevice(_device, nullptr);
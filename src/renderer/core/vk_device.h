@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/10/08 19:13:42 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/14 16:59:54 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 02:53:36 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -28,15 +28,18 @@ namespace mlx
 			inline VkDevice& get() noexcept { return _device; }
 
 			inline VkPhysicalDevice& getPhysicalDevice() noexcept { return _physical_device; }
+			inline bool supportsIncrementalPresent() const noexcept { return _supports_incremental_present; }
 
 		private:
 			void pickPhysicalDevice();
 			bool checkDeviceExtensionSupport(VkPhysicalDevice device);
+			bool isExtensionSupported(VkPhysicalDevice device, const char* extension);
 			int deviceScore(VkPhysicalDevice device, VkSurfaceKHR surface);
 
 		private:
 			VkPhysicalDevice _physical_device = VK_NULL_HANDLE;
 			VkDevice _device = VK_NULL_HANDLE;
+			bool _supports_incremental_present = false;
 	};
 }
 
@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/01/23 18:40:44 by maldavid          #+#    #+#             */
-/*   Updated: 2024/01/20 08:18:07 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 02:45:08 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -30,13 +30,13 @@ namespace mlx
 
 		auto device = Render_Core::get().getDevice().get();
 
-		std::array<VkDescriptorSetLayout, MAX_FRAMES_IN_FLIGHT> layouts;
-		layouts.fill(layout->get());
+		std::vector<VkDescriptorSetLayout> layouts(renderer->getFramesInFlight(), layout->get());
+		_desc_set.resize(renderer->getFramesInFlight());
 
 		VkDescriptorSetAllocateInfo allocInfo{};
 		allocInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
 		allocInfo.descriptorPool = _pool->get();
-		allocInfo.descriptorSetCount = static_cast<std::uint32_t>(MAX_FRAMES_IN_FLIGHT);
+		allocInfo.descriptorSetCount = static_cast<std::uint32_t>(layouts.size());
 		allocInfo.pSetLayouts = layouts.data();
 
 		VkResult res = vkAllocateDescriptorSets(device, &allocInfo, _desc_set.data());
@@ -52,7 +52,7 @@ namespace mlx
 		MLX_PROFILE_FUNCTION();
 		auto device = Render_Core::get().getDevice().get();
 
-		for(int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
+		for(std::size_t i = 0; i < _desc_set.size(); i++)
 		{
 			VkDescriptorBufferInfo bufferInfo{};
 			bufferInfo.buffer = ubo->get(i);
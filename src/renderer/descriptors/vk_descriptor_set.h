@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/01/23 18:39:36 by maldavid          #+#    #+#             */
-/*   Updated: 2024/01/20 07:17:39 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 02:45:08 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -15,7 +15,7 @@
 
 #include <mlx_profile.h>
 #include <volk.h>
-#include <array>
+#include <vector>
 #include <renderer/core/render_core.h>
 
 namespace mlx
@@ -37,14 +37,14 @@ namespace mlx
 			VkDescriptorSet& operator()() noexcept;
 			VkDescriptorSet& get() noexcept;
 
-			inline const std::array<VkDescriptorSet, MAX_FRAMES_IN_FLIGHT>& getAllFramesDescriptorSets() const { return _desc_set; }
+			inline const std::vector<VkDescriptorSet>& getAllFramesDescriptorSets() const { return _desc_set; }
 
 			void destroy() noexcept;
 
 			~DescriptorSet() = default;
 
 		private:
-			std::array<VkDescriptorSet, MAX_FRAMES_IN_FLIGHT> _desc_set;
+			std::vector<VkDescriptorSet> _desc_set;
 			class DescriptorPool* _pool = nullptr;
 			class DescriptorSetLayout* _layout = nullptr;
 			class Renderer* _renderer = nullptr;
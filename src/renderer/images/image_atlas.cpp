@@ -0,0 +1,96 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   image_atlas.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 03:18:01 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/19 03:20:01 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <renderer/images/image_atlas.h>
+#include <renderer/core/render_core.h>
+#include <core/profiler.h>
+
+#ifdef IMAGE_OPTIMIZED
+	#define TILING VK_IMAGE_TILING_OPTIMAL
+#else
+	#define TILING VK_IMAGE_TILING_LINEAR
+#endif
+
+namespace mlx
+{
+	constexpr const int PADDING = 1; // keeps neighbours out of the samples of scaled images
+
+	static bool packInPage(AtlasPage& page, std::uint32_t width, std::uint32_t height, VkRect2D& region)
+	{
+		stbrp_rect rect{};
+		rect.w = static_cast<stbrp_coord>(width + PADDING);
+		rect.h = static_cast<stbrp_coord>(height + PADDING);
+		if(!stbrp_pack_rects(&page.context, &rect, 1) || !rect.was_packed)
+			return false;
+		region.offset = { static_cast<std::int32_t>(rect.x), static_cast<std::int32_t>(rect.y) };
+		region.extent = { width, height };
+		return true;
+	}
+
+	AtlasPage* ImageAtlas::allocate(std::uint32_t width, std::uint32_t height, VkRect2D& region)
+	{
+		MLX_PROFILE_FUNCTION();
+		for(AtlasPage& page : _pages)
+		{
+			if(packInPage(page, width, height, region))
+			{
+				page.images++;
+				return &page;
+			}
+		}
+
+		AtlasPage& page = _pages.emplace_back();
+		page.atlas = this;
+		page.nodes.resize(PAGE_SIZE);
+		stbrp_init_target(&page.context, PAGE_SIZE, PAGE_SIZE, page.nodes.data(), static_cast<int>(page.nodes.size()));
+		#ifdef DEBUG
+			page.image.create(PAGE_SIZE, PAGE_SIZE, FORMAT, TILING, VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, "__mlx_image_atlas_page");
+		#else
+			page.image.create(PAGE_SIZE, PAGE_SIZE, FORMAT, TILING, VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, nullptr);
+		#endif
+		page.image.createImageView(VK_IMAGE_VIEW_TYPE_2D, VK_IMAGE_ASPECT_COLOR_BIT);
+		page.image.createSampler();
+
+		CmdBuffer& cmd = Render_Core::get().getSingleTimeCmdBuffer();
+		cmd.beginRecord();
+		page.image.transitionLayout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &cmd);
+		cmd.clearColorImage(page.image, VkClearColorValue{ { 0.f, 0.f, 0.f, 0.f } });
+		page.image.transitionLayout(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, &cmd);
+		cmd.endRecord();
+		cmd.submitIdle();
+
+		packInPage(page, width, height, region); // always fits in an empty page
+		page.images++;
+		return &page;
+	}
+
+	void ImageAtlas::release(AtlasPage* page) noexcept
+	{
+		MLX_PROFILE_FUNCTION();
+		if(page == nullptr || --page->images != 0)
+			return;
+		vkDeviceWaitIdle(Render_Core::get().getDevice().get()); // the page may still be used by frames in flight
+		page->set.destroy();
+		page->image.destroy();
+		_pages.remove_if([=](const AtlasPage& p) { return &p == page; });
+	}
+
+	void ImageAtlas::destroy() noexcept
+	{
+		for(AtlasPage& page : _pages)
+		{
+			page.set.destroy();
+			page.image.destroy();
+		}
+		_pages.clear();
+	}
+}
@@ -0,0 +1,61 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   image_atlas.h                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 03:18:01 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/19 03:20:01 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef __MLX_IMAGE_ATLAS__
+#define __MLX_IMAGE_ATLAS__
+
+#include <mlx_profile.h>
+#include <list>
+#include <vector>
+#include <cstdint>
+#include <stb_rect_pack.h>
+
+#include <utils/non_copyable.h>
+#include <renderer/images/vk_image.h>
+#include <renderer/descriptors/vk_descriptor_set.h>
+
+namespace mlx
+{
+	struct AtlasPage
+	{
+		Image image;
+		DescriptorSet set; // shared by all the images of the page
+		std::vector<stbrp_node> nodes;
+		stbrp_context context;
+		class ImageAtlas* atlas = nullptr;
+		std::size_t images = 0;
+		bool set_updated = false;
+	};
+
+	// small images are packed in shared pages instead of having their own image, view, sampler and descriptor set
+	class ImageAtlas : public NonCopyable
+	{
+		public:
+			static constexpr std::uint32_t PAGE_SIZE = 1024;
+			static constexpr std::uint32_t MAX_IMAGE_SIZE = 64;
+			static constexpr VkFormat FORMAT = VK_FORMAT_R8G8B8A8_UNORM;
+
+			ImageAtlas() = default;
+
+			inline bool fits(std::uint32_t width, std::uint32_t height, VkFormat format) const noexcept { return format == FORMAT && width != 0 && height != 0 && width <= MAX_IMAGE_SIZE && height <= MAX_IMAGE_SIZE; }
+			AtlasPage* allocate(std::uint32_t width, std::uint32_t height, VkRect2D& region);
+			void release(AtlasPage* page) noexcept; // stb_rect_pack cannot free a single rect, a page is destroyed once all its images are
+			void destroy() noexcept;
+
+			~ImageAtlas() = default;
+
+		private:
+			std::list<AtlasPage> _pages;
+	};
+}
+
+#endif
@@ -0,0 +1,81 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   image_transform.h                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 03:40:53 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/19 03:46:59 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef __MLX_IMAGE_TRANSFORM__
+#define __MLX_IMAGE_TRANSFORM__
+
+#include <mlx_profile.h>
+#include <volk.h>
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <cmath>
+#include <utils/combine_hash.h>
+
+namespace mlx
+{
+	struct ImageTransform
+	{
+		glm::vec2 scale = { 1.f, 1.f };
+		glm::vec2 pivot = { 0.f, 0.f }; // point of the image drawn at the put position, the image is scaled and rotated around it
+		float angle = 0.f; // degrees, clockwise
+		std::uint32_t tint = 0xFFFFFFFF; // RGBA bytes multiplied with the image colors
+		bool flip_x = false; // flips mirror the image in place
+		bool flip_y = false;
+
+		inline bool operator==(const ImageTransform& rhs) const noexcept
+		{
+			return scale == rhs.scale && pivot == rhs.pivot && angle == rhs.angle && tint == rhs.tint && flip_x == rhs.flip_x && flip_y == rhs.flip_y;
+		}
+		inline bool operator!=(const ImageTransform& rhs) const noexcept { return !(*this == rhs); }
+
+		inline glm::vec4 getTint() const noexcept
+		{
+			return glm::vec4(tint & 0xFF, (tint >> 8) & 0xFF, (tint >> 16) & 0xFF, (tint >> 24) & 0xFF) / 255.f;
+		}
+
+		inline VkRect2D getBounds(int x, int y, std::uint32_t width, std::uint32_t height) const noexcept // area covered by a width x height image put at x, y
+		{
+			if(*this == ImageTransform{})
+				return { { x, y }, { width, height } };
+			float radians = glm::radians(angle);
+			glm::vec2 rotation(std::cos(radians), std::sin(radians));
+			glm::vec2 min(INFINITY);
+			glm::vec2 max(-INFINITY);
+			for(glm::vec2 corner : { glm::vec2(0.f, 0.f), glm::vec2(width, 0.f), glm::vec2(width, height), glm::vec2(0.f, height) })
+			{
+				glm::vec2 pos = (corner - pivot) * scale;
+				pos = glm::vec2(pos.x * rotation.x - pos.y * rotation.y, pos.x * rotation.y + pos.y * rotation.x) + glm::vec2(x, y);
+				min = glm::min(min, pos);
+				max = glm::max(max, pos);
+			}
+			min = glm::floor(min);
+			max = glm::ceil(max);
+			return { { static_cast<std::int32_t>(min.x), static_cast<std::int32_t>(min.y) }, { static_cast<std::uint32_t>(max.x - min.x), static_cast<std::uint32_t>(max.y - min.y) } };
+		}
+	};
+}
+
+namespace std
+{
+	template <>
+	struct hash<mlx::ImageTransform>
+	{
+		std::size_t operator()(const mlx::ImageTransform& t) const noexcept
+		{
+			std::size_t hash = 0;
+			mlx::hashCombine(hash, t.scale.x, t.scale.y, t.pivot.x, t.pivot.y, t.angle, t.tint, t.flip_x, t.flip_y);
+			return hash;
+		}
+	};
+}
+
+#endif
@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/03/31 18:03:35 by maldavid          #+#    #+#             */
-/*   Updated: 2024/09/14 00:04:29 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 04:39:21 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -15,8 +15,56 @@
 #include <renderer/buffers/vk_buffer.h>
 #include <renderer/renderer.h>
 #include <core/profiler.h>
+#include <core/job_system.h>
+#include <algorithm>
+#include <functional>
+#include <cstdlib>
 #include <cstring>
+#include <cmath>
+#include <limits>
 
+namespace mlx
+{
+	// stb_image allocations, the first one of the decoded image size lands in the memory targeted by the calling thread
+	struct DecodeTarget
+	{
+		void* memory = nullptr;
+		std::size_t size = 0;
+		bool used = true;
+	};
+	static thread_local DecodeTarget __decode_target;
+
+	static void* decodeMalloc(std::size_t size)
+	{
+		if(!__decode_target.used && (size == __decode_target.size || size + DECODE_PADDING == __decode_target.size))
+		{
+			__decode_target.used = true;
+			return __decode_target.memory;
+		}
+		return std::malloc(size);
+	}
+
+	static void* decodeRealloc(void* ptr, std::size_t size)
+	{
+		if(ptr == nullptr || ptr != __decode_target.memory)
+			return std::realloc(ptr, size);
+		void* moved = std::malloc(size); // the target cannot grow, moves out of it
+		if(moved != nullptr)
+			std::memcpy(moved, ptr, std::min(size, __decode_target.size));
+		return moved;
+	}
+
+	static void decodeFree(void* ptr)
+	{
+		if(ptr != nullptr && ptr == __decode_target.memory)
+			return;
+		std::free(ptr);
+	}
+}
+
+#define STBI_MALLOC(size) mlx::decodeMalloc(size)
+#define STBI_REALLOC(ptr, size) mlx::decodeRealloc(ptr, size)
+#define STBI_FREE(ptr) mlx::decodeFree(ptr)
 #define STB_IMAGE_IMPLEMENTATION
 #ifdef MLX_COMPILER_GCC
 	#pragma GCC diagnostic push
@@ -38,16 +86,109 @@ namespace mlx
 	void Texture::create(std::uint8_t* pixels, std::uint32_t width, std::uint32_t height, VkFormat format, const char* name, bool dedicated_memory)
 	{
 		MLX_PROFILE_FUNCTION();
+		createResources(width, height, format, name, dedicated_memory);
+
+		CmdBuffer& cmd = Render_Core::get().getSingleTimeCmdBuffer();
+		cmd.beginRecord();
+		transitionLayout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &cmd);
+		Buffer staging_buffer;
+		if(pixels != nullptr)
+		{
+			std::size_t size = width * height * formatSize(format);
+			#ifdef DEBUG
+				staging_buffer.create(Buffer::kind::dynamic, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, name, pixels);
+			#else
+				staging_buffer.create(Buffer::kind::dynamic, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, nullptr, pixels);
+			#endif
+			cmd.copyBufferToImage(staging_buffer, *this);
+		}
+		else // blank textures are cleared by the GPU instead of uploading zeros
+			cmd.clearColorImage(*this, VkClearColorValue{ { 0.f, 0.f, 0.f, 0.f } });
+		transitionLayout(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, &cmd);
+		cmd.endRecord();
+		cmd.submitIdle();
+		staging_buffer.destroy();
+		_is_blank = (pixels == nullptr);
+	}
+
+	void Texture::create(Buffer& staging_buffer, std::uint32_t width, std::uint32_t height, VkFormat format, const char* name, CmdBuffer& cmd, ImageAtlas* atlas)
+	{
+		MLX_PROFILE_FUNCTION();
+		VkRect2D region;
+		if(atlas != nullptr && atlas->fits(width, height, format) && (_page = atlas->allocate(width, height, region)) != nullptr)
+		{
+			Image::createRegion(_page->image, region);
+			glm::vec2 page_size(ImageAtlas::PAGE_SIZE, ImageAtlas::PAGE_SIZE);
+			glm::vec2 uv_min = glm::vec2(region.offset.x, region.offset.y) / page_size;
+			createGeometry(width, height, uv_min, uv_min + glm::vec2(width, height) / page_size, name);
+		}
+		else
+			createResources(width, height, format, name, false);
+		transitionLayout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &cmd);
+		cmd.copyBufferToImage(staging_buffer, *this);
+		transitionLayout(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, &cmd);
+	}
+
+	void Texture::createAlias(const Texture& shared) noexcept
+	{
+		static_cast<Image&>(*this) = shared;
+		_vbo = shared._vbo;
+		_ibo = shared._ibo;
+		_page = shared._page;
+		_uv_min = shared._uv_min;
+		_uv_max = shared._uv_max;
+		#ifdef DEBUG
+			_name = shared._name;
+		#endif
+		_shares_image = true;
+	}
+
+	void Texture::detach()
+	{
+		MLX_PROFILE_FUNCTION();
+		if(!_shares_image && _page == nullptr)
+			return;
+		openCPUmap(); // the shared content is read back before leaving it
+		AtlasPage* page = (_shares_image ? nullptr : _page);
+		if(page != nullptr)
+		{
+			vkDeviceWaitIdle(Render_Core::get().getDevice().get()); // the quad buffers may still be used by frames in flight
+			_vbo.destroy();
+			_ibo.destroy();
+		}
+		_shares_image = false;
+		_page = nullptr;
+		#ifdef DEBUG
+			std::string name = _name;
+			createResources(getWidth(), getHeight(), getFormat(), name.c_str(), false, getFilter());
+		#else
+			createResources(getWidth(), getHeight(), getFormat(), nullptr, false, getFilter());
+		#endif
+		transitionLayout(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+		Image::copyFromBuffer(*_buf_map);
+		if(page != nullptr)
+			page->atlas->release(page);
+		_has_set_been_updated = false;
+		_modifications_count++;
+	}
+
+	void Texture::createResources(std::uint32_t width, std::uint32_t height, VkFormat format, const char* name, bool dedicated_memory, VkFilter filter)
+	{
 		Image::create(width, height, format, TILING, VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, name, dedicated_memory);
 		Image::createImageView(VK_IMAGE_VIEW_TYPE_2D, VK_IMAGE_ASPECT_COLOR_BIT);
-		Image::createSampler();
-		transitionLayout(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+		Image::createSampler(filter);
+		createGeometry(width, height, glm::vec2(0.f, 0.f), glm::vec2(1.f, 1.f), name);
+	}
 
+	void Texture::createGeometry(std::uint32_t width, std::uint32_t height, glm::vec2 uv_min, glm::vec2 uv_max, [[maybe_unused]] const char* name)
+	{
+		_uv_min = uv_min;
+		_uv_max = uv_max;
 		std::vector<Vertex> vertexData = {
-			{{0, 0},			{1.f, 1.f, 1.f, 1.f},	{0.0f, 0.0f}},
-			{{width, 0},		{1.f, 1.f, 1.f, 1.f},	{1.0f, 0.0f}},
-			{{width, height},	{1.f, 1.f, 1.f, 1.f},	{1.0f, 1.0f}},
-			{{0, height},		{1.f, 1.f, 1.f, 1.f},	{0.0f, 1.0f}}
+			{{0, 0},			{1.f, 1.f, 1.f, 1.f},	{uv_min.x, uv_min.y}},
+			{{width, 0},		{1.f, 1.f, 1.f, 1.f},	{uv_max.x, uv_min.y}},
+			{{width, height},	{1.f, 1.f, 1.f, 1.f},	{uv_max.x, uv_max.y}},
+			{{0, height},		{1.f, 1.f, 1.f, 1.f},	{uv_min.x, uv_max.y}}
 		};
 
 		std::vector<std::uint16_t> indexData = { 0, 1, 2, 2, 3, 0 };
@@ -60,45 +201,25 @@ namespace mlx
 			_vbo.create(sizeof(Vertex) * vertexData.size(), vertexData.data(), nullptr);
 			_ibo.create(sizeof(std::uint16_t) * indexData.size(), indexData.data(), nullptr);
 		#endif
-
-		Buffer staging_buffer;
-		std::size_t size = width * height * formatSize(format);
-		if(pixels != nullptr)
-		{
-			#ifdef DEBUG
-				staging_buffer.create(Buffer::kind::dynamic, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, name, pixels);
-			#else
-				staging_buffer.create(Buffer::kind::dynamic, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, nullptr, pixels);
-			#endif
-		}
-		else
-		{
-			std::vector<std::uint32_t> default_pixels(width * height, 0x00000000);
-			#ifdef DEBUG
-				staging_buffer.create(Buffer::kind::dynamic, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, name, default_pixels.data());
-			#else
-				staging_buffer.create(Buffer::kind::dynamic, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, nullptr, default_pixels.data());
-			#endif
-		}
-		Image::copyFromBuffer(staging_buffer);
-		staging_buffer.destroy();
 	}
 
 	void Texture::setPixel(int x, int y, std::uint32_t color) noexcept
 	{
 		MLX_PROFILE_FUNCTION();
-		if(x < 0 || y < 0 || static_cast<std::uint32_t>(x) > getWidth() || static_cast<std::uint32_t>(y) > getHeight())
+		if(x < 0 || y < 0 || static_cast<std::uint32_t>(x) >= getWidth() || static_cast<std::uint32_t>(y) >= getHeight())
 			return;
 		if(_map == nullptr)
 			openCPUmap();
+		if(_cpu_map[(y * getWidth()) + x] == color)
+			return;
 		_cpu_map[(y * getWidth()) + x] = color;
-		_has_been_modified = true;
+		markModified({ { x, y }, { 1, 1 } });
 	}
 
 	int Texture::getPixel(int x, int y) noexcept
 	{
 		MLX_PROFILE_FUNCTION();
-		if(x < 0 || y < 0 || static_cast<std::uint32_t>(x) > getWidth() || static_cast<std::uint32_t>(y) > getHeight())
+		if(x < 0 || y < 0 || static_cast<std::uint32_t>(x) >= getWidth() || static_cast<std::uint32_t>(y) >= getHeight())
 			return 0;
 		if(_map == nullptr)
 			openCPUmap();
@@ -110,6 +231,13 @@ namespace mlx
 		return *reinterpret_cast<int*>(bytes);
 	}
 
+	std::uint32_t* Texture::getCPUMap()
+	{
+		if(_map == nullptr)
+			openCPUmap();
+		return _cpu_map.data();
+	}
+
 	void Texture::openCPUmap()
 	{
 		MLX_PROFILE_FUNCTION();
@@ -126,72 +254,277 @@ namespace mlx
 		#else
 			_buf_map->create(Buffer::kind::dynamic, size, VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, nullptr);
 		#endif
-		Image::copyToBuffer(*_buf_map);
 		_buf_map->mapMem(&_map);
 		_cpu_map = std::vector<std::uint32_t>(getWidth() * getHeight(), 0);
-		std::memcpy(_cpu_map.data(), _map, size);
+		if(!_is_blank) // a blank texture is already known to be zeroed, the readback would only wait on the GPU
+		{
+			Image::copyToBuffer(*_buf_map);
+			std::memcpy(_cpu_map.data(), _map, size);
+		}
 		#ifdef DEBUG
 			core::error::report(e_kind::message, "Texture : mapped CPU memory using staging buffer");
 		#endif
 	}
 
-	void Texture::render(std::array<VkDescriptorSet, 2>& sets, Renderer& renderer, int x, int y)
+	VkDescriptorSet Texture::prepareSet(Renderer& renderer)
 	{
 		MLX_PROFILE_FUNCTION();
-		if(_has_been_modified)
+		if(!rectIsEmpty(_modified_area))
 		{
-			std::memcpy(_map, _cpu_map.data(), _cpu_map.size() * formatSize(getFormat()));
-			Image::copyFromBuffer(*_buf_map);
-			_has_been_modified = false;
+			// only the modified rows are copied to the staging memory and only the modified area is uploaded
+			std::size_t pixel_size = formatSize(getFormat());
+			for(std::uint32_t y = 0; y < _modified_area.extent.height; y++)
+			{
+				std::size_t offset = (static_cast<std::size_t>(_modified_area.offset.y + y) * getWidth() + _modified_area.offset.x) * pixel_size;
+				std::memcpy(static_cast<std::uint8_t*>(_map) + offset, reinterpret_cast<const std::uint8_t*>(_cpu_map.data()) + offset, _modified_area.extent.width * pixel_size);
+			}
+			Image::copyFromBuffer(*_buf_map, _modified_area);
+			_modified_area = { { 0, 0 }, { 0, 0 } };
 		}
-		if(!_set.isInit())
-			_set = renderer.getFragDescriptorSet().duplicate();
+		DescriptorSet& set = (_page != nullptr ? _page->set : _set); // atlased images are drawn with the set of their page
+		bool& set_updated = (_page != nullptr ? _page->set_updated : _has_set_been_updated);
+		if(!set.isInit())
+			set = renderer.getFragDescriptorSet().duplicate();
 		if(getLayout() != VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL)
 			transitionLayout(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
-		if(!_has_set_been_updated)
-			updateSet(0);
+		if(!set_updated)
+		{
+			set.writeDescriptor(0, *this);
+			set_updated = true;
+		}
+		return set.get();
+	}
+
+	void Texture::render(std::array<VkDescriptorSet, 2>& sets, Renderer& renderer, int x, int y, VkRect2D region, const ImageTransform& transform)
+	{
+		MLX_PROFILE_FUNCTION();
+		VkDescriptorSet set = prepareSet(renderer);
 		auto cmd = renderer.getActiveCmdBuffer();
 		_vbo.bind(renderer);
 		_ibo.bind(renderer);
-		glm::vec2 translate(x, y);
-		vkCmdPushConstants(cmd.get(), renderer.getPipeline().getPipelineLayout(), VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(translate), &translate);
-		sets[1] = _set.get();
+		ModelPushConstant model(glm::vec2(x, y));
+		if(region.extent.width != 0 && region.extent.height != 0) // the quad is shrunk to the region and its UVs moved to it
+		{
+			glm::vec2 size(getWidth(), getHeight());
+			model.scale = glm::vec2(region.extent.width, region.extent.height) / size;
+			model.uv_scale = model.scale;
+			model.uv_offset = _uv_min * (1.f - model.scale) + glm::vec2(region.offset.x, region.offset.y) * (_uv_max - _uv_min) / size;
+		}
+		if(transform != ImageTransform{})
+		{
+			// flips mirror the UVs of the drawn part so the quad does not move
+			if(transform.flip_x)
+			{
+				model.uv_offset.x += (_uv_min.x + _uv_max.x) * model.uv_scale.x;
+				model.uv_scale.x = -model.uv_scale.x;
+			}
+			if(transform.flip_y)
+			{
+				model.uv_offset.y += (_uv_min.y + _uv_max.y) * model.uv_scale.y;
+				model.uv_scale.y = -model.uv_scale.y;
+			}
+			model.scale *= transform.scale;
+			model.origin = -transform.pivot * transform.scale;
+			float radians = glm::radians(transform.angle);
+			model.rotation = glm::vec2(std::cos(radians), std::sin(radians));
+			model.tint = transform.getTint();
+		}
+		vkCmdPushConstants(cmd.get(), renderer.getPipeline().getPipelineLayout(), VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(model), &model);
+		sets[1] = set;
 		vkCmdBindDescriptorSets(renderer.getActiveCmdBuffer().get(), VK_PIPELINE_BIND_POINT_GRAPHICS, renderer.getPipeline().getPipelineLayout(), 0, sets.size(), sets.data(), 0, nullptr);
 		vkCmdDrawIndexed(cmd.get(), static_cast<std::uint32_t>(_ibo.getSize() / sizeof(std::uint16_t)), 1, 0, 0, 0);
 	}
 
+	void Texture::setFilter(VkFilter filter)
+	{
+		MLX_PROFILE_FUNCTION();
+		if(getFilter() == filter)
+			return;
+		vkDeviceWaitIdle(Render_Core::get().getDevice().get()); // the sampler may still be used by frames in flight
+		Image::destroySampler();
+		Image::createSampler(filter);
+		_has_set_been_updated = false;
+		_modifications_count++;
+	}
+
 	void Texture::destroy() noexcept
 	{
 		MLX_PROFILE_FUNCTION();
-		Image::destroy();
 		_set.destroy();
 		if(_buf_map.has_value())
 			_buf_map->destroy();
+		if(_shares_image) // the resources belong to the shared texture
+		{
+			Image::forget();
+			_shares_image = false;
+			_page = nullptr;
+			return;
+		}
+		if(_page != nullptr)
+		{
+			Image::forget();
+			_page->atlas->release(_page);
+			_page = nullptr;
+		}
+		else
+			Image::destroy();
 		_vbo.destroy();
 		_ibo.destroy();
 	}
 
-	Texture stbTextureLoad(std::filesystem::path file, int* w, int* h)
+	// decodes with the given stb loader straight in dst, see the allocation hooks above
+	template <typename Loader>
+	static bool decodeInto(Loader&& load, const char* source, std::uint8_t* dst, int width, int height)
+	{
+		std::size_t size = static_cast<std::size_t>(width) * height * 4;
+		int w;
+		int h;
+		int channels;
+
+		__decode_target = { dst, size + DECODE_PADDING, false };
+		std::uint8_t* data = load(&w, &h, &channels);
+		__decode_target = {};
+
+		if(data == nullptr)
+		{
+			core::error::report(e_kind::error, "Image : unable to decode '%s', %s", source, stbi_failure_reason());
+			return false;
+		}
+		bool same_size = (w == width && h == height);
+		if(!same_size)
+			core::error::report(e_kind::error, "Image : '%s' has been modified while being loaded", source);
+		else if(data != dst) // the decoder built its output somewhere else
+			std::memcpy(dst, data, size);
+		if(data != dst)
+			stbi_image_free(data);
+		return same_size;
+	}
+
+	// decoded by the job system in a mapped staging buffer, the calling thread runs other jobs while waiting
+	static Texture uploadDecodedImage(int width, int height, const char* name, ImageAtlas* atlas, const std::function<bool(std::uint8_t*)>& decode)
 	{
-		MLX_PROFILE_FUNCTION();
 		Texture texture;
+		Buffer staging_buffer;
+		staging_buffer.create(Buffer::kind::staging, static_cast<std::size_t>(width) * height * 4 + DECODE_PADDING, VK_BUFFER_USAGE_TRANSFER_SRC_BIT, name);
+		void* map = nullptr;
+		staging_buffer.mapMem(&map);
+
+		bool decoded = JobSystem::get().async([&]() { return decode(static_cast<std::uint8_t*>(map)); }).get();
+
+		if(decoded)
+		{
+			staging_buffer.flush();
+			CmdBuffer& cmd = Render_Core::get().getSingleTimeCmdBuffer();
+			cmd.beginRecord();
+			texture.create(staging_buffer, width, height, VK_FORMAT_R8G8B8A8_UNORM, name, cmd, atlas);
+			cmd.endRecord();
+			cmd.submitIdle();
+		}
+		else
+			texture.create(nullptr, width, height, VK_FORMAT_R8G8B8A8_UNORM, name);
+		staging_buffer.destroy();
+		return texture;
+	}
+
+	Texture stbTextureLoad(std::filesystem::path file, int* w, int* h, ImageAtlas* atlas)
+	{
+		MLX_PROFILE_FUNCTION();
 		int channels;
-		std::uint8_t* data = nullptr;
+		int width;
+		int height;
 		std::string filename = file.string();
 
 		if(!std::filesystem::exists(std::move(file)))
 			core::error::report(e_kind::fatal_error, "Image : file not found '%s'", filename.c_str());
 		if(stbi_is_hdr(filename.c_str()))
 			core::error::report(e_kind::fatal_error, "Texture : unsupported image format '%s'", filename.c_str());
-		int dummy_w;
-		int dummy_h;
-		data = stbi_load(filename.c_str(), (w == nullptr ? &dummy_w : w), (h == nullptr ? &dummy_h : h), &channels, 4);
+		if(!stbi_info(filename.c_str(), &width, &height, &channels))
+			core::error::report(e_kind::fatal_error, "Image : unable to read '%s', %s", filename.c_str(), stbi_failure_reason());
+		if(w != nullptr)
+			*w = width;
+		if(h != nullptr)
+			*h = height;
+
 		#ifdef DEBUG
-			texture.create(data, (w == nullptr ? dummy_w : *w), (h == nullptr ? dummy_h : *h), VK_FORMAT_R8G8B8A8_UNORM, filename.c_str());
+			const char* name = filename.c_str();
 		#else
-			texture.create(data, (w == nullptr ? dummy_w : *w), (h == nullptr ? dummy_h : *h), VK_FORMAT_R8G8B8A8_UNORM, nullptr);
+			const char* name = nullptr;
 		#endif
-		stbi_image_free(data);
-		return texture;
+		return uploadDecodedImage(width, height, name, atlas, [&](std::uint8_t* dst)
+		{
+			return stbDecodeImage(filename, dst, width, height);
+		});
+	}
+
+	Texture stbTextureLoadFromMemory(const std::uint8_t* data, std::size_t size, int width, int height, ImageAtlas* atlas)
+	{
+		MLX_PROFILE_FUNCTION();
+		#ifdef DEBUG
+			const char* name = "__mlx_memory_image";
+		#else
+			const char* name = nullptr;
+		#endif
+		return uploadDecodedImage(width, height, name, atlas, [&](std::uint8_t* dst)
+		{
+			return decodeInto([&](int* w, int* h, int* channels)
+			{
+				return stbi_load_from_memory(data, static_cast<int>(size), w, h, channels, 4);
+			}, "memory buffer", dst, width, height);
+		});
+	}
+
+	bool stbImageSize(const std::filesystem::path& file, int* w, int* h)
+	{
+		MLX_PROFILE_FUNCTION();
+		std::string filename = file.string();
+		if(!std::filesystem::exists(file))
+		{
+			core::error::report(e_kind::error, "Image : file not found '%s'", filename.c_str());
+			return false;
+		}
+		if(stbi_is_hdr(filename.c_str()))
+		{
+			core::error::report(e_kind::error, "Texture : unsupported image format '%s'", filename.c_str());
+			return false;
+		}
+		int channels;
+		if(!stbi_info(filename.c_str(), w, h, &channels))
+		{
+			core::error::report(e_kind::error, "Image : unable to read '%s', %s", filename.c_str(), stbi_failure_reason());
+			return false;
+		}
+		return true;
+	}
+
+	bool stbImageSizeFromMemory(const std::uint8_t* data, std::size_t size, int* w, int* h)
+	{
+		MLX_PROFILE_FUNCTION();
+		if(size > static_cast<std::size_t>(std::numeric_limits<int>::max()))
+		{
+			core::error::report(e_kind::error, "Image : memory buffer too big (%zu bytes)", size);
+			return false;
+		}
+		if(stbi_is_hdr_from_memory(data, static_cast<int>(size)))
+		{
+			core::error::report(e_kind::error, "Texture : unsupported image format in memory buffer");
+			return false;
+		}
+		int channels;
+		if(!stbi_info_from_memory(data, static_cast<int>(size), w, h, &channels))
+		{
+			core::error::report(e_kind::error, "Image : unable to read memory buffer, %s", stbi_failure_reason());
+			return false;
+		}
+		return true;
+	}
+
+	bool stbDecodeImage(const std::filesystem::path& file, std::uint8_t* dst, int width, int height)
+	{
+		MLX_PROFILE_FUNCTION();
+		std::string filename = file.string();
+		return decodeInto([&](int* w, int* h, int* channels)
+		{
+			return stbi_load(filename.c_str(), w, h, channels, 4);
+		}, filename.c_str(), dst, width, height);
 	}
 }
@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/03/08 02:24:58 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/14 19:06:07 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 04:39:21 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -15,10 +15,14 @@
 
 #include <filesystem>
 #include <array>
+#include <glm/glm.hpp>
 #include <renderer/images/vk_image.h>
+#include <renderer/images/image_atlas.h>
+#include <renderer/images/image_transform.h>
 #include <renderer/descriptors/vk_descriptor_set.h>
 #include <renderer/buffers/vk_ibo.h>
 #include <renderer/buffers/vk_vbo.h>
+#include <utils/rect.h>
 #include <mlx_profile.h>
 #ifdef DEBUG
 	#include <string>
@@ -32,21 +36,37 @@ namespace mlx
 			Texture() = default;
 
 			void create(std::uint8_t* pixels, std::uint32_t width, std::uint32_t height, VkFormat format, const char* name, bool dedicated_memory = false);
-			void render(std::array<VkDescriptorSet, 2>& sets, class Renderer& renderer, int x, int y);
+			void create(Buffer& staging_buffer, std::uint32_t width, std::uint32_t height, VkFormat format, const char* name, CmdBuffer& cmd, ImageAtlas* atlas = nullptr); // records the upload in cmd, the staging buffer must live until it is executed
+			void createAlias(const Texture& shared) noexcept; // uses the GPU resources of shared, which must outlive the alias or detach from it
+			void detach(); // gives a shared or atlased texture its own copy of the image
+			void render(std::array<VkDescriptorSet, 2>& sets, class Renderer& renderer, int x, int y, VkRect2D region = {}, const ImageTransform& transform = {}); // an empty region renders the whole texture
+			VkDescriptorSet prepareSet(class Renderer& renderer); // uploads the CPU writes and returns the set sampling the texture
 			void destroy() noexcept override;
 
+			void setFilter(VkFilter filter); // the image must not be shared nor atlased
+
 			void setPixel(int x, int y, std::uint32_t color) noexcept;
 			int getPixel(int x, int y) noexcept;
 
+			std::uint32_t* getCPUMap(); // call markModified once done writing in it
+			inline void markModified() noexcept { markModified({ { 0, 0 }, { getWidth(), getHeight() } }); }
+			inline void markModified(VkRect2D area) noexcept { _modified_area = rectUnion(_modified_area, area); _modifications_count++; } // only the area is uploaded
+			inline void markRenderedTo() noexcept { _is_blank = false; } // the GPU writes in it, its content must be read back
+
 			inline void setDescriptor(DescriptorSet&& set) noexcept { _set = set; }
 			inline VkDescriptorSet getSet() noexcept { return _set.isInit() ? _set.get() : VK_NULL_HANDLE; }
 			inline void updateSet(int binding) noexcept { _set.writeDescriptor(binding, *this); _has_set_been_updated = true; }
 			inline bool hasBeenUpdated() const noexcept { return _has_set_been_updated; }
-			inline constexpr void resetUpdate() noexcept { _has_set_been_updated = false; }
+			inline void resetUpdate() noexcept { _has_set_been_updated = false; if(_page != nullptr) _page->set_updated = false; }
+			inline std::uint64_t getModificationsCount() const noexcept { return _modifications_count; }
+			inline bool sharesImage() const noexcept { return _shares_image; }
+			inline bool isInAtlas() const noexcept { return _page != nullptr; }
 
 			~Texture() = default;
 
 		private:
+			void createResources(std::uint32_t width, std::uint32_t height, VkFormat format, const char* name, bool dedicated_memory, VkFilter filter = VK_FILTER_NEAREST);
+			void createGeometry(std::uint32_t width, std::uint32_t height, glm::vec2 uv_min, glm::vec2 uv_max, const char* name);
 			void openCPUmap();
 
 		private:
@@ -58,12 +78,24 @@ namespace mlx
 			DescriptorSet _set;
 			std::vector<std::uint32_t> _cpu_map;
 			std::optional<Buffer> _buf_map = std::nullopt;
+			glm::vec2 _uv_min = { 0.f, 0.f };
+			glm::vec2 _uv_max = { 1.f, 1.f };
 			void* _map = nullptr;
-			bool _has_been_modified = false;
+			AtlasPage* _page = nullptr; // aliases do not own their slot
+			VkRect2D _modified_area = { { 0, 0 }, { 0, 0 } }; // written in the CPU map since the last upload
+			std::uint64_t _modifications_count = 0;
 			bool _has_set_been_updated = false;
+			bool _shares_image = false;
+			bool _is_blank = false; // cleared at creation and never written by the GPU since, no need to read it back
 	};
 
-	Texture stbTextureLoad(std::filesystem::path file, int* w, int* h);
+	constexpr const std::size_t DECODE_PADDING = 1; // stb_image allocates some decoded images one byte larger
+
+	Texture stbTextureLoad(std::filesystem::path file, int* w, int* h, ImageAtlas* atlas = nullptr);
+	Texture stbTextureLoadFromMemory(const std::uint8_t* data, std::size_t size, int width, int height, ImageAtlas* atlas = nullptr); // size given by stbImageSizeFromMemory
+	bool stbImageSize(const std::filesystem::path& file, int* w, int* h); // only reads the header, errors are not fatal
+	bool stbImageSizeFromMemory(const std::uint8_t* data, std::size_t size, int* w, int* h);
+	bool stbDecodeImage(const std::filesystem::path& file, std::uint8_t* dst, int width, int height); // thread safe, decodes in RGBA straight in dst which must have DECODE_PADDING spare bytes, errors are not fatal
 }
 
 #endif
@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/01/11 01:00:13 by maldavid          #+#    #+#             */
-/*   Updated: 2024/01/11 01:21:52 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 03:46:59 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -22,16 +22,24 @@ namespace mlx
 	struct TextureRenderDescriptor : public DrawableResource
 	{
 		Texture* texture;
+		VkRect2D region; // part of the texture to draw, the whole texture if empty
+		ImageTransform transform;
 		int x;
 		int y;
 
-		TextureRenderDescriptor(Texture* _texture, int _x, int _y) : texture(_texture), x(_x), y(_y) {}
-		inline bool operator==(const TextureRenderDescriptor& rhs) const { return texture == rhs.texture && x == rhs.x && y == rhs.y; }
+		TextureRenderDescriptor(Texture* _texture, int _x, int _y, VkRect2D _region = {}, const ImageTransform& _transform = {}) : texture(_texture), region(_region), transform(_transform), x(_x), y(_y) {}
+		inline bool operator==(const TextureRenderDescriptor& rhs) const
+		{
+			return texture == rhs.texture && x == rhs.x && y == rhs.y &&
+				region.offset.x == rhs.region.offset.x && region.offset.y == rhs.region.offset.y &&
+				region.extent.width == rhs.region.extent.width && region.extent.height == rhs.region.extent.height &&
+				transform == rhs.transform;
+		}
 		inline void render(std::array<VkDescriptorSet, 2>& sets, class Renderer& renderer) override
 		{
 			if(!texture->isInit())
 				return;
-			texture->render(sets, renderer, x, y);
+			texture->render(sets, renderer, x, y, region, transform);
 		}
 		inline void resetUpdate() override 
 		{
@@ -39,6 +47,20 @@ namespace mlx
 				return;
 			texture->resetUpdate();
 		}
+		inline std::size_t getSignature() const noexcept override
+		{
+			std::size_t hash = 0;
+			hashCombine(hash, texture, x, y, region.offset.x, region.offset.y, region.extent.width, region.extent.height, transform, texture->getModificationsCount());
+			return hash;
+		}
+		inline VkRect2D getBounds() const noexcept override
+		{
+			if(!texture->isInit())
+				return { { x, y }, { 0, 0 } };
+			if(region.extent.width != 0 && region.extent.height != 0)
+				return transform.getBounds(x, y, region.extent.width, region.extent.height);
+			return transform.getBounds(x, y, texture->getWidth(), texture->getHeight());
+		}
 	};
 }
 
@@ -50,7 +72,7 @@ namespace std
 		std::size_t operator()(const mlx::TextureRenderDescriptor& d) const noexcept
 		{
 			std::size_t hash = 0;
-			mlx::hashCombine(hash, d.texture, d.x, d.y);
+			mlx::hashCombine(hash, d.texture, d.x, d.y, d.region.offset.x, d.region.offset.y, d.region.extent.width, d.region.extent.height, d.transform);
 			return hash;
 		}
 	};
@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/01/11 00:56:15 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/25 13:53:59 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 03:46:59 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -27,10 +27,10 @@ namespace mlx
 
 			inline void clear() { _texture_descriptors.clear(); }
 
-			inline std::pair<DrawableResource*, bool> registerTexture(Texture* texture, int x, int y)
+			inline std::pair<DrawableResource*, bool> registerTexture(Texture* texture, int x, int y, VkRect2D region = {}, const ImageTransform& transform = {})
 			{
 				MLX_PROFILE_FUNCTION();
-				auto res = _texture_descriptors.emplace(texture, x, y);
+				auto res = _texture_descriptors.emplace(texture, x, y, region, transform);
 				return std::make_pair(static_cast<DrawableResource*>(&const_cast<TextureRenderDescriptor&>(*res.first)), res.second);
 			}
 
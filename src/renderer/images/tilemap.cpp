@@ -0,0 +1,158 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   tilemap.cpp                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 03:31:33 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/19 03:38:47 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <core/errors.h>
+#include <renderer/images/tilemap.h>
+#include <renderer/renderer.h>
+#include <renderer/core/render_core.h>
+#include <core/profiler.h>
+#include <algorithm>
+
+namespace mlx
+{
+	void Tilemap::create(Texture* tileset, std::uint32_t tile_width, std::uint32_t tile_height, std::uint32_t columns, std::uint32_t rows)
+	{
+		MLX_PROFILE_FUNCTION();
+		_tileset = tileset;
+		_tile_size = glm::ivec2(tile_width, tile_height);
+		_columns = columns;
+		_rows = rows;
+
+		std::vector<std::uint16_t> cells(static_cast<std::size_t>(columns) * rows, EMPTY_TILE);
+		_grid.create(columns, rows, VK_FORMAT_R16_UINT, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, "__mlx_tilemap_grid");
+		_grid.createImageView(VK_IMAGE_VIEW_TYPE_2D, VK_IMAGE_ASPECT_COLOR_BIT);
+		_grid.createSampler(); // unused by texelFetch but required by combined image samplers
+		_staging.create(Buffer::kind::dynamic, cells.size() * sizeof(std::uint16_t), VK_BUFFER_USAGE_TRANSFER_SRC_BIT, "__mlx_tilemap_grid", cells.data());
+		void* map = nullptr;
+		_staging.mapMem(&map);
+		_cells = static_cast<std::uint16_t*>(map);
+		_whole_grid_modified = true; // uploaded with the first render
+
+		// unit quad scaled to the drawn area, its UVs become pixel positions in that area
+		std::vector<Vertex> vertexData = {
+			{{0, 0},	{1.f, 1.f, 1.f, 1.f},	{0.f, 0.f}},
+			{{1, 0},	{1.f, 1.f, 1.f, 1.f},	{1.f, 0.f}},
+			{{1, 1},	{1.f, 1.f, 1.f, 1.f},	{1.f, 1.f}},
+			{{0, 1},	{1.f, 1.f, 1.f, 1.f},	{0.f, 1.f}}
+		};
+		std::vector<std::uint16_t> indexData = { 0, 1, 2, 2, 3, 0 };
+		_vbo.create(sizeof(Vertex) * vertexData.size(), vertexData.data(), "__mlx_tilemap_quad");
+		_ibo.create(sizeof(std::uint16_t) * indexData.size(), indexData.data(), "__mlx_tilemap_quad");
+		#ifdef DEBUG
+			core::error::report(e_kind::message, "Tilemap : created a %ux%u grid of %dx%d tiles", columns, rows, _tile_size.x, _tile_size.y);
+		#endif
+	}
+
+	void Tilemap::setTile(std::uint32_t column, std::uint32_t row, std::uint16_t tile) noexcept
+	{
+		MLX_PROFILE_FUNCTION();
+		std::uint32_t cell = row * _columns + column;
+		if(_cells[cell] == tile)
+			return;
+		_cells[cell] = tile;
+		_modifications_count++;
+		if(_whole_grid_modified)
+			return;
+		// past a quarter of the grid a single copy of it is cheaper than one region per cell
+		if(_modified_cells.size() >= static_cast<std::size_t>(_columns) * _rows / 4)
+		{
+			_modified_cells.clear();
+			_whole_grid_modified = true;
+		}
+		else
+			_modified_cells.push_back(cell);
+	}
+
+	void Tilemap::uploadModifiedCells()
+	{
+		MLX_PROFILE_FUNCTION();
+		if(!_whole_grid_modified && _modified_cells.empty())
+			return;
+		_staging.flush();
+
+		CmdBuffer& cmd = Render_Core::get().getSingleTimeCmdBuffer();
+		cmd.beginRecord();
+		_grid.transitionLayout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &cmd);
+		if(_whole_grid_modified)
+			cmd.copyBufferToImage(_staging, _grid);
+		else
+		{
+			std::vector<VkBufferImageCopy> regions(_modified_cells.size());
+			for(std::size_t i = 0; i < _modified_cells.size(); i++)
+			{
+				std::uint32_t cell = _modified_cells[i];
+				regions[i].bufferOffset = cell * sizeof(std::uint16_t); // two bytes per modified cell
+				regions[i].imageSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 };
+				regions[i].imageOffset = { static_cast<std::int32_t>(cell % _columns), static_cast<std::int32_t>(cell / _columns), 0 };
+				regions[i].imageExtent = { 1, 1, 1 };
+			}
+			cmd.copyBufferToImage(_staging, _grid, regions);
+		}
+		_grid.transitionLayout(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, &cmd);
+		cmd.endRecord();
+		cmd.submitIdle();
+
+		_modified_cells.clear();
+		_whole_grid_modified = false;
+	}
+
+	void Tilemap::render(std::array<VkDescriptorSet, 2>& sets, Renderer& renderer, int x, int y, std::uint32_t width, std::uint32_t height)
+	{
+		MLX_PROFILE_FUNCTION();
+		if(_tileset == nullptr || !_tileset->isInit())
+			return;
+		uploadModifiedCells();
+		if(!_set.isInit())
+			_set = renderer.getFragDescriptorSet().duplicate();
+		if(!_has_set_been_updated)
+		{
+			_set.writeDescriptor(0, _grid);
+			_has_set_been_updated = true;
+		}
+		std::array<VkDescriptorSet, 3> tilemap_sets = { sets[0], _tileset->prepareSet(renderer), _set.get() };
+
+		ModelPushConstant model(glm::vec2(x, y));
+		model.scale = glm::vec2(width, height);
+		model.uv_scale = model.scale;
+		TilemapPushConstant map;
+		map.scroll = _scroll;
+		map.tile_size = _tile_size;
+		map.tileset_origin = { _tileset->getOffset().x, _tileset->getOffset().y }; // atlased tilesets are a region of their page
+		map.grid_size = glm::ivec2(_columns, _rows);
+		map.tileset_columns = static_cast<std::int32_t>(_tileset->getWidth()) / _tile_size.x;
+
+		CmdBuffer& cmd = renderer.getActiveCmdBuffer();
+		GraphicPipeline& pipeline = renderer.getTilemapPipeline();
+		pipeline.bindPipeline(cmd);
+		_vbo.bind(renderer);
+		_ibo.bind(renderer);
+		vkCmdPushConstants(cmd.get(), pipeline.getPipelineLayout(), VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(model), &model);
+		vkCmdPushConstants(cmd.get(), pipeline.getPipelineLayout(), VK_SHADER_STAGE_FRAGMENT_BIT, sizeof(model), sizeof(map), &map);
+		vkCmdBindDescriptorSets(cmd.get(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline.getPipelineLayout(), 0, tilemap_sets.size(), tilemap_sets.data(), 0, nullptr);
+		vkCmdDrawIndexed(cmd.get(), static_cast<std::uint32_t>(_ibo.getSize() / sizeof(std::uint16_t)), 1, 0, 0, 0);
+		renderer.getPipeline().bindPipeline(cmd); // the following resources expect the textured pipeline
+	}
+
+	void Tilemap::destroy() noexcept
+	{
+		MLX_PROFILE_FUNCTION();
+		vkDeviceWaitIdle(Render_Core::get().getDevice().get()); // the grid may still be read by frames in flight
+		_set.destroy();
+		_staging.destroy();
+		_grid.destroy();
+		_vbo.destroy();
+		_ibo.destroy();
+		_cells = nullptr;
+		_modified_cells.clear();
+		_tileset = nullptr;
+	}
+}
@@ -0,0 +1,128 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   tilemap.h                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 03:31:03 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/19 03:38:47 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef __MLX_TILEMAP__
+#define __MLX_TILEMAP__
+
+#include <mlx_profile.h>
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <renderer/images/texture.h>
+#include <renderer/core/drawable_resource.h>
+#include <renderer/buffers/vk_buffer.h>
+#include <renderer/buffers/vk_ibo.h>
+#include <renderer/buffers/vk_vbo.h>
+#include <utils/combine_hash.h>
+
+namespace mlx
+{
+	// a grid of tile indices drawn in a single quad, the tiles are looked up in the tileset by the fragment shader
+	class Tilemap
+	{
+		public:
+			static constexpr std::uint16_t EMPTY_TILE = 0xFFFF;
+			static constexpr std::uint32_t MAX_GRID_SIZE = 4096; // smallest maxImageDimension2D allowed by Vulkan
+
+			Tilemap() = default;
+
+			void create(Texture* tileset, std::uint32_t tile_width, std::uint32_t tile_height, std::uint32_t columns, std::uint32_t rows);
+			void setTile(std::uint32_t column, std::uint32_t row, std::uint16_t tile) noexcept; // only the modified cells are uploaded
+			void render(std::array<VkDescriptorSet, 2>& sets, class Renderer& renderer, int x, int y, std::uint32_t width, std::uint32_t height);
+			void destroy() noexcept;
+
+			inline void setScroll(int x, int y) noexcept { if(_scroll == glm::ivec2(x, y)) return; _scroll = { x, y }; _modifications_count++; }
+			inline void forgetTileset() noexcept { _tileset = nullptr; _modifications_count++; } // the tileset has been destroyed
+			inline void resetUpdate() noexcept { _has_set_been_updated = false; if(_tileset != nullptr) _tileset->resetUpdate(); }
+
+			inline Texture* getTileset() const noexcept { return _tileset; }
+			inline std::uint32_t getTilesCount() const noexcept { return (_tileset->getWidth() / _tile_size.x) * (_tileset->getHeight() / _tile_size.y); }
+			inline std::uint32_t getColumns() const noexcept { return _columns; }
+			inline std::uint32_t getRows() const noexcept { return _rows; }
+			inline std::uint64_t getModificationsCount() const noexcept { return _modifications_count; }
+			inline bool isInit() const noexcept { return _grid.isInit(); }
+
+			~Tilemap() = default;
+
+		private:
+			void uploadModifiedCells();
+
+		private:
+			Image _grid; // one R16_UINT texel per cell
+			Buffer _staging; // mirrors the grid, the modified cells are copied from it
+			C_VBO _vbo;
+			C_IBO _ibo;
+			DescriptorSet _set;
+			std::vector<std::uint32_t> _modified_cells;
+			glm::ivec2 _tile_size = { 0, 0 };
+			glm::ivec2 _scroll = { 0, 0 };
+			Texture* _tileset = nullptr;
+			std::uint16_t* _cells = nullptr;
+			std::uint64_t _modifications_count = 0;
+			std::uint32_t _columns = 0;
+			std::uint32_t _rows = 0;
+			bool _whole_grid_modified = false;
+			bool _has_set_been_updated = false;
+	};
+
+	struct TilemapRenderDescriptor : public DrawableResource
+	{
+		Tilemap* tilemap;
+		int x;
+		int y;
+		std::uint32_t width;
+		std::uint32_t height;
+
+		TilemapRenderDescriptor(Tilemap* _tilemap, int _x, int _y, std::uint32_t _width, std::uint32_t _height) : tilemap(_tilemap), x(_x), y(_y), width(_width), height(_height) {}
+		inline bool operator==(const TilemapRenderDescriptor& rhs) const
+		{
+			return tilemap == rhs.tilemap && x == rhs.x && y == rhs.y && width == rhs.width && height == rhs.height;
+		}
+		inline void render(std::array<VkDescriptorSet, 2>& sets, class Renderer& renderer) override
+		{
+			if(!tilemap->isInit())
+				return;
+			tilemap->render(sets, renderer, x, y, width, height);
+		}
+		inline void resetUpdate() override
+		{
+			if(!tilemap->isInit())
+				return;
+			tilemap->resetUpdate();
+		}
+		inline std::size_t getSignature() const noexcept override
+		{
+			std::size_t hash = 0;
+			Texture* tileset = tilemap->getTileset();
+			hashCombine(hash, tilemap, x, y, width, height, tilemap->getModificationsCount(), (tileset != nullptr ? tileset->getModificationsCount() : 0));
+			return hash;
+		}
+		inline VkRect2D getBounds() const noexcept override { return { { x, y }, { width, height } }; }
+	};
+}
+
+namespace std
+{
+	template <>
+	struct hash<mlx::TilemapRenderDescriptor>
+	{
+		std::size_t operator()(const mlx::TilemapRenderDescriptor& d) const noexcept
+		{
+			std::size_t hash = 0;
+			mlx::hashCombine(hash, d.tilemap, d.x, d.y, d.width, d.height);
+			return hash;
+		}
+	};
+}
+
+#endif
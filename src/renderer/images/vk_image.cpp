@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/01/25 11:59:07 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/14 17:28:25 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 03:59:12 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -103,6 +103,7 @@ namespace mlx
 	{
 		_width = width;
 		_height = height;
+		_offset = { 0, 0 };
 		_format = format;
 		_tiling = tiling;
 
@@ -157,16 +158,19 @@ namespace mlx
 		#endif
 	}
 
-	void Image::createSampler() noexcept
+	void Image::createSampler(VkFilter filter) noexcept
 	{
+		_filter = filter;
 		VkSamplerCreateInfo info{};
 		info.sType = VK_STRUCTURE_TYPE_SAMPLER_CREATE_INFO;
-		info.magFilter = VK_FILTER_NEAREST;
-		info.minFilter = VK_FILTER_NEAREST;
+		info.magFilter = filter;
+		info.minFilter = filter;
 		info.mipmapMode = VK_SAMPLER_MIPMAP_MODE_NEAREST;
-		info.addressModeU = VK_SAMPLER_ADDRESS_MODE_REPEAT;
-		info.addressModeV = VK_SAMPLER_ADDRESS_MODE_REPEAT;
-		info.addressModeW = VK_SAMPLER_ADDRESS_MODE_REPEAT;
+		// filtered samples on the borders would otherwise blend in the opposite side of the image
+		VkSamplerAddressMode address_mode = (filter == VK_FILTER_LINEAR ? VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE : VK_SAMPLER_ADDRESS_MODE_REPEAT);
+		info.addressModeU = address_mode;
+		info.addressModeV = address_mode;
+		info.addressModeW = address_mode;
 		info.minLod = -1000;
 		info.maxLod = 1000;
 		info.anisotropyEnable = VK_FALSE;
@@ -197,6 +201,40 @@ namespace mlx
 		cmd.submitIdle();
 	}
 
+	void Image::copyFromBuffer(Buffer& buffer, VkRect2D area, CmdBuffer* cmd)
+	{
+		VkBufferImageCopy region{};
+		region.bufferOffset = (static_cast<VkDeviceSize>(area.offset.y) * _width + area.offset.x) * formatSize(_format);
+		region.bufferRowLength = _width;
+		region.bufferImageHeight = _height;
+		region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		region.imageSubresource.mipLevel = 0;
+		region.imageSubresource.baseArrayLayer = 0;
+		region.imageSubresource.layerCount = 1;
+		region.imageOffset = { _offset.x + area.offset.x, _offset.y + area.offset.y, 0 };
+		region.imageExtent = { area.extent.width, area.extent.height, 1 };
+
+		bool singleTime = (cmd == nullptr);
+		if(singleTime)
+		{
+			cmd = &Render_Core::get().getSingleTimeCmdBuffer();
+			cmd->beginRecord();
+		}
+
+		VkImageLayout layout_save = _layout;
+		transitionLayout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, cmd);
+
+		cmd->copyBufferToImage(buffer, *this, { region });
+
+		transitionLayout(layout_save, cmd);
+
+		if(singleTime)
+		{
+			cmd->endRecord();
+			cmd->submitIdle();
+		}
+	}
+
 	void Image::copyToBuffer(Buffer& buffer)
 	{
 		CmdBuffer& cmd = Render_Core::get().getSingleTimeCmdBuffer();
@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/01/25 11:54:21 by maldavid          #+#    #+#             */
-/*   Updated: 2024/01/19 06:10:15 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 04:23:29 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -48,11 +48,22 @@ namespace mlx
 				_layout = layout;
 			}
 			void create(std::uint32_t width, std::uint32_t height, VkFormat format, VkImageTiling tiling, VkImageUsageFlags usage, const char* name, bool decated_memory = false);
+			inline void createRegion(const Image& image, VkRect2D region) noexcept // a part of an image owned by someone else
+			{
+				*this = image;
+				_offset = region.offset;
+				_width = region.extent.width;
+				_height = region.extent.height;
+			}
 			void createImageView(VkImageViewType type, VkImageAspectFlags aspectFlags) noexcept;
-			void createSampler() noexcept;
+			void createSampler(VkFilter filter = VK_FILTER_NEAREST) noexcept;
 			void copyFromBuffer(class Buffer& buffer);
+			void copyFromBuffer(class Buffer& buffer, VkRect2D area, CmdBuffer* cmd = nullptr); // the buffer holds the whole image, only the area is copied
 			void copyToBuffer(class Buffer& buffer);
 			void transitionLayout(VkImageLayout new_layout, CmdBuffer* cmd = nullptr);
+			inline void discardContent() noexcept { _layout = VK_IMAGE_LAYOUT_UNDEFINED; } // next transition will not preserve the content
+			inline void setLayout(VkImageLayout layout) noexcept { _layout = layout; } // for transitions done by a render pass
+			inline void forget() noexcept { _image = VK_NULL_HANDLE; _image_view = VK_NULL_HANDLE; _sampler = VK_NULL_HANDLE; } // for images owned by someone else
 			virtual void destroy() noexcept;
 
 			inline VkImage get() noexcept { return _image; }
@@ -62,13 +73,15 @@ namespace mlx
 			inline VkImageTiling getTiling() const noexcept { return _tiling; }
 			inline VkImageLayout getLayout() const noexcept { return _layout; }
 			inline VkSampler getSampler() const noexcept { return _sampler; }
+			inline VkFilter getFilter() const noexcept { return _filter; }
 			inline std::uint32_t getWidth() const noexcept { return _width; }
 			inline std::uint32_t getHeight() const noexcept { return _height; }
+			inline VkOffset2D getOffset() const noexcept { return _offset; } // position of the region in the image, transfers only touch the region
 			inline bool isInit() const noexcept { return _image != VK_NULL_HANDLE; }
 
 			virtual ~Image() = default;
 
-		private:
+		protected:
 			void destroySampler() noexcept;
 			void destroyImageView() noexcept;
 
@@ -83,8 +96,10 @@ namespace mlx
 			VkFormat _format;
 			VkImageTiling _tiling;
 			VkImageLayout _layout = VK_IMAGE_LAYOUT_UNDEFINED;
+			VkFilter _filter = VK_FILTER_NEAREST;
 			std::uint32_t _width = 0;
 			std::uint32_t _height = 0;
+			VkOffset2D _offset = { 0, 0 };
 	};
 }
 
@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/12/18 21:27:38 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/14 17:05:21 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 04:09:37 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -30,10 +30,17 @@ namespace mlx
 
 			layout(push_constant) uniform uModelPushConstant {
 				vec2 vec;
-			} uTranslate;
+				vec2 scale;
+				vec2 uv_offset;
+				vec2 uv_scale;
+				vec4 tint;
+				vec2 origin;
+				vec2 rotation; // cosine and sine of the angle
+			} uPush;
 
 			out gl_PerVertex {
 				vec4 gl_Position;
+				float gl_PointSize;
 			};
 
 			layout(location = 0) out struct {
@@ -43,65 +50,93 @@ namespace mlx
 
 			void main()
 			{
-				Out.Color = aColor;
-				Out.UV = aUV;
-				vec2 pos = aPos + uTranslate.vec;
+				Out.Color = aColor * uPush.tint;
+				Out.UV = aUV * uPush.uv_scale + uPush.uv_offset;
+				vec2 pos = aPos * uPush.scale + uPush.origin;
+				pos = vec2(pos.x * uPush.rotation.x - pos.y * uPush.rotation.y, pos.x * uPush.rotation.y + pos.y * uPush.rotation.x) + uPush.vec;
 				gl_Position = uProj.mat * vec4(pos.x, pos.y, 0.0, 1.0);
+				gl_PointSize = 1.0; // one pixel points for the sparse pixel puts
 			}
 	*/
 	const std::vector<std::uint32_t> vertex_shader = {	// precompiled vertex shader
-		0x07230203,0x00010000,0x0008000b,0x0000003b,0x00000000,0x00020011,0x00000001,0x0006000b,
+		0x07230203,0x00010000,0x0008000b,0x00000057,0x00000000,0x00020011,0x00000001,0x0006000b,
 		0x00000001,0x4c534c47,0x6474732e,0x3035342e,0x00000000,0x0003000e,0x00000000,0x00000001,
-		0x000a000f,0x00000000,0x00000004,0x6e69616d,0x00000000,0x0000000b,0x0000000f,0x00000015,
-		0x0000001b,0x00000026,0x00030003,0x00000002,0x000001c2,0x00040005,0x00000004,0x6e69616d,
-		0x00000000,0x00030005,0x00000009,0x00000000,0x00050006,0x00000009,0x00000000,0x6f6c6f43,
-		0x00000072,0x00040006,0x00000009,0x00000001,0x00005655,0x00030005,0x0000000b,0x0074754f,
-		0x00040005,0x0000000f,0x6c6f4361,0x0000726f,0x00030005,0x00000015,0x00565561,0x00030005,
-		0x0000001a,0x00736f70,0x00040005,0x0000001b,0x736f5061,0x00000000,0x00070005,0x0000001d,
-		0x646f4d75,0x75506c65,0x6f436873,0x6174736e,0x0000746e,0x00040006,0x0000001d,0x00000000,
-		0x00636576,0x00050005,0x0000001f,0x61725475,0x616c736e,0x00006574,0x00060005,0x00000024,
-		0x505f6c67,0x65567265,0x78657472,0x00000000,0x00060006,0x00000024,0x00000000,0x505f6c67,
-		0x7469736f,0x006e6f69,0x00030005,0x00000026,0x00000000,0x00050005,0x00000028,0x6f725075,
-		0x7463656a,0x006e6f69,0x00040006,0x00000028,0x00000000,0x0074616d,0x00040005,0x0000002a,
-		0x6f725075,0x0000006a,0x00040047,0x0000000b,0x0000001e,0x00000000,0x00040047,0x0000000f,
-		0x0000001e,0x00000001,0x00040047,0x00000015,0x0000001e,0x00000002,0x00040047,0x0000001b,
-		0x0000001e,0x00000000,0x00050048,0x0000001d,0x00000000,0x00000023,0x00000000,0x00030047,
-		0x0000001d,0x00000002,0x00050048,0x00000024,0x00000000,0x0000000b,0x00000000,0x00030047,
-		0x00000024,0x00000002,0x00040048,0x00000028,0x00000000,0x00000005,0x00050048,0x00000028,
-		0x00000000,0x00000023,0x00000000,0x00050048,0x00000028,0x00000000,0x00000007,0x00000010,
-		0x00030047,0x00000028,0x00000002,0x00040047,0x0000002a,0x00000022,0x00000000,0x00040047,
-		0x0000002a,0x00000021,0x00000000,0x00020013,0x00000002,0x00030021,0x00000003,0x00000002,
-		0x00030016,0x00000006,0x00000020,0x00040017,0x00000007,0x00000006,0x00000004,0x00040017,
-		0x00000008,0x00000006,0x00000002,0x0004001e,0x00000009,0x00000007,0x00000008,0x00040020,
-		0x0000000a,0x00000003,0x00000009,0x0004003b,0x0000000a,0x0000000b,0x00000003,0x00040015,
-		0x0000000c,0x00000020,0x00000001,0x0004002b,0x0000000c,0x0000000d,0x00000000,0x00040020,
-		0x0000000e,0x00000001,0x00000007,0x0004003b,0x0000000e,0x0000000f,0x00000001,0x00040020,
-		0x00000011,0x00000003,0x00000007,0x0004002b,0x0000000c,0x00000013,0x00000001,0x00040020,
-		0x00000014,0x00000001,0x00000008,0x0004003b,0x00000014,0x00000015,0x00000001,0x00040020,
-		0x00000017,0x00000003,0x00000008,0x00040020,0x00000019,0x00000007,0x00000008,0x0004003b,
-		0x00000014,0x0000001b,0x00000001,0x0003001e,0x0000001d,0x00000008,0x00040020,0x0000001e,
-		0x00000009,0x0000001d,0x0004003b,0x0000001e,0x0000001f,0x00000009,0x00040020,0x00000020,
-		0x00000009,0x00000008,0x0003001e,0x00000024,0x00000007,0x00040020,0x00000025,0x00000003,
-		0x00000024,0x0004003b,0x00000025,0x00000026,0x00000003,0x00040018,0x00000027,0x00000007,
-		0x00000004,0x0003001e,0x00000028,0x00000027,0x00040020,0x00000029,0x00000002,0x00000028,
-		0x0004003b,0x00000029,0x0000002a,0x00000002,0x00040020,0x0000002b,0x00000002,0x00000027,
-		0x00040015,0x0000002e,0x00000020,0x00000000,0x0004002b,0x0000002e,0x0000002f,0x00000000,
-		0x00040020,0x00000030,0x00000007,0x00000006,0x0004002b,0x0000002e,0x00000033,0x00000001,
-		0x0004002b,0x00000006,0x00000036,0x00000000,0x0004002b,0x00000006,0x00000037,0x3f800000,
-		0x00050036,0x00000002,0x00000004,0x00000000,0x00000003,0x000200f8,0x00000005,0x0004003b,
-		0x00000019,0x0000001a,0x00000007,0x0004003d,0x00000007,0x00000010,0x0000000f,0x00050041,
-		0x00000011,0x00000012,0x0000000b,0x0000000d,0x0003003e,0x00000012,0x00000010,0x0004003d,
-		0x00000008,0x00000016,0x00000015,0x00050041,0x00000017,0x00000018,0x0000000b,0x00000013,
-		0x0003003e,0x00000018,0x00000016,0x0004003d,0x00000008,0x0000001c,0x0000001b,0x00050041,
-		0x00000020,0x00000021,0x0000001f,0x0000000d,0x0004003d,0x00000008,0x00000022,0x00000021,
-		0x00050081,0x00000008,0x00000023,0x0000001c,0x00000022,0x0003003e,0x0000001a,0x00000023,
-		0x00050041,0x0000002b,0x0000002c,0x0000002a,0x0000000d,0x0004003d,0x00000027,0x0000002d,
-		0x0000002c,0x00050041,0x00000030,0x00000031,0x0000001a,0x0000002f,0x0004003d,0x00000006,
-		0x00000032,0x00000031,0x00050041,0x00000030,0x00000034,0x0000001a,0x00000033,0x0004003d,
-		0x00000006,0x00000035,0x00000034,0x00070050,0x00000007,0x00000038,0x00000032,0x00000035,
-		0x00000036,0x00000037,0x00050091,0x00000007,0x00000039,0x0000002d,0x00000038,0x00050041,
-		0x00000011,0x0000003a,0x00000026,0x0000000d,0x0003003e,0x0000003a,0x00000039,0x000100fd,
-		0x00010038
+		0x000a000f,0x00000000,0x00000002,0x6e69616d,0x00000000,0x00000003,0x00000004,0x00000005,
+		0x00000006,0x00000007,0x00030003,0x00000002,0x000001c2,0x00040005,0x00000002,0x6e69616d,
+		0x00000000,0x00030005,0x00000008,0x00000000,0x00050006,0x00000008,0x00000000,0x6f6c6f43,
+		0x00000072,0x00040006,0x00000008,0x00000001,0x00005655,0x00030005,0x00000003,0x0074754f,
+		0x00040005,0x00000004,0x6c6f4361,0x0000726f,0x00030005,0x00000005,0x00565561,0x00040005,
+		0x00000006,0x736f5061,0x00000000,0x00070005,0x00000009,0x646f4d75,0x75506c65,0x6f436873,
+		0x6174736e,0x0000746e,0x00040006,0x00000009,0x00000000,0x00636576,0x00050006,0x00000009,
+		0x00000001,0x6c616373,0x00000065,0x00060006,0x00000009,0x00000002,0x6f5f7675,0x65736666,
+		0x00000074,0x00060006,0x00000009,0x00000003,0x735f7675,0x656c6163,0x00000000,0x00050006,
+		0x00000009,0x00000004,0x746e6974,0x00000000,0x00050006,0x00000009,0x00000005,0x6769726f,
+		0x00006e69,0x00060006,0x00000009,0x00000006,0x61746f72,0x6e6f6974,0x00000000,0x00040005,
+		0x0000000a,0x73755075,0x00000068,0x00060005,0x0000000b,0x505f6c67,0x65567265,0x78657472,
+		0x00000000,0x00060006,0x0000000b,0x00000000,0x505f6c67,0x7469736f,0x006e6f69,0x00070006,
+		0x0000000b,0x00000001,0x505f6c67,0x746e696f,0x657a6953,0x00000000,0x00050005,0x0000000c,
+		0x6f725075,0x7463656a,0x006e6f69,0x00040006,0x0000000c,0x00000000,0x0074616d,0x00040005,
+		0x0000000d,0x6f725075,0x0000006a,0x00040047,0x00000003,0x0000001e,0x00000000,0x00040047,
+		0x00000004,0x0000001e,0x00000001,0x00040047,0x00000005,0x0000001e,0x00000002,0x00040047,
+		0x00000006,0x0000001e,0x00000000,0x00050048,0x00000009,0x00000000,0x00000023,0x00000000,
+		0x00050048,0x00000009,0x00000001,0x00000023,0x00000008,0x00050048,0x00000009,0x00000002,
+		0x00000023,0x00000010,0x00050048,0x00000009,0x00000003,0x00000023,0x00000018,0x00050048,
+		0x00000009,0x00000004,0x00000023,0x00000020,0x00050048,0x00000009,0x00000005,0x00000023,
+		0x00000030,0x00050048,0x00000009,0x00000006,0x00000023,0x00000038,0x00030047,0x00000009,
+		0x00000002,0x00050048,0x0000000b,0x00000000,0x0000000b,0x00000000,0x00050048,0x0000000b,
+		0x00000001,0x0000000b,0x00000001,0x00030047,0x0000000b,0x00000002,0x00040048,0x0000000c,
+		0x00000000,0x00000005,0x00050048,0x0000000c,0x00000000,0x00000023,0x00000000,0x00050048,
+		0x0000000c,0x00000000,0x00000007,0x00000010,0x00030047,0x0000000c,0x00000002,0x00040047,
+		0x0000000d,0x00000022,0x00000000,0x00040047,0x0000000d,0x00000021,0x00000000,0x00020013,
+		0x0000000e,0x00030021,0x0000000f,0x0000000e,0x00030016,0x00000010,0x00000020,0x00040017,
+		0x00000011,0x00000010,0x00000004,0x00040017,0x00000012,0x00000010,0x00000002,0x0004001e,
+		0x00000008,0x00000011,0x00000012,0x00040020,0x00000013,0x00000003,0x00000008,0x0004003b,
+		0x00000013,0x00000003,0x00000003,0x00040015,0x00000014,0x00000020,0x00000001,0x0004002b,
+		0x00000014,0x00000015,0x00000000,0x0004002b,0x00000014,0x00000016,0x00000001,0x0004002b,
+		0x00000014,0x00000017,0x00000002,0x0004002b,0x00000014,0x00000018,0x00000003,0x0004002b,
+		0x00000014,0x00000019,0x00000004,0x0004002b,0x00000014,0x0000001a,0x00000005,0x0004002b,
+		0x00000014,0x0000001b,0x00000006,0x00040020,0x0000001c,0x00000001,0x00000011,0x0004003b,
+		0x0000001c,0x00000004,0x00000001,0x00040020,0x0000001d,0x00000003,0x00000011,0x00040020,
+		0x0000001e,0x00000001,0x00000012,0x0004003b,0x0000001e,0x00000005,0x00000001,0x0004003b,
+		0x0000001e,0x00000006,0x00000001,0x00040020,0x0000001f,0x00000003,0x00000012,0x00040020,
+		0x00000020,0x00000003,0x00000010,0x0009001e,0x00000009,0x00000012,0x00000012,0x00000012,
+		0x00000012,0x00000011,0x00000012,0x00000012,0x00040020,0x00000021,0x00000009,0x00000009,
+		0x0004003b,0x00000021,0x0000000a,0x00000009,0x00040020,0x00000022,0x00000009,0x00000012,
+		0x00040020,0x00000023,0x00000009,0x00000011,0x0004001e,0x0000000b,0x00000011,0x00000010,
+		0x00040020,0x00000024,0x00000003,0x0000000b,0x0004003b,0x00000024,0x00000007,0x00000003,
+		0x00040018,0x00000025,0x00000011,0x00000004,0x0003001e,0x0000000c,0x00000025,0x00040020,
+		0x00000026,0x00000002,0x0000000c,0x0004003b,0x00000026,0x0000000d,0x00000002,0x00040020,
+		0x00000027,0x00000002,0x00000025,0x0004002b,0x00000010,0x00000028,0x00000000,0x0004002b,
+		0x00000010,0x00000029,0x3f800000,0x00050036,0x0000000e,0x00000002,0x00000000,0x0000000f,
+		0x000200f8,0x0000002a,0x0004003d,0x00000011,0x0000002b,0x00000004,0x00050041,0x00000023,
+		0x0000002c,0x0000000a,0x00000019,0x0004003d,0x00000011,0x0000002d,0x0000002c,0x00050085,
+		0x00000011,0x0000002e,0x0000002b,0x0000002d,0x00050041,0x0000001d,0x0000002f,0x00000003,
+		0x00000015,0x0003003e,0x0000002f,0x0000002e,0x0004003d,0x00000012,0x00000030,0x00000005,
+		0x00050041,0x00000022,0x00000031,0x0000000a,0x00000018,0x0004003d,0x00000012,0x00000032,
+		0x00000031,0x00050041,0x00000022,0x00000033,0x0000000a,0x00000017,0x0004003d,0x00000012,
+		0x00000034,0x00000033,0x00050085,0x00000012,0x00000035,0x00000030,0x00000032,0x00050081,
+		0x00000012,0x00000036,0x00000035,0x00000034,0x00050041,0x0000001f,0x00000037,0x00000003,
+		0x00000016,0x0003003e,0x00000037,0x00000036,0x0004003d,0x00000012,0x00000038,0x00000006,
+		0x00050041,0x00000022,0x00000039,0x0000000a,0x00000016,0x0004003d,0x00000012,0x0000003a,
+		0x00000039,0x00050041,0x00000022,0x0000003b,0x0000000a,0x0000001a,0x0004003d,0x00000012,
+		0x0000003c,0x0000003b,0x00050085,0x00000012,0x0000003d,0x00000038,0x0000003a,0x00050081,
+		0x00000012,0x0000003e,0x0000003d,0x0000003c,0x00050041,0x00000022,0x0000003f,0x0000000a,
+		0x0000001b,0x0004003d,0x00000012,0x00000040,0x0000003f,0x00050051,0x00000010,0x00000041,
+		0x0000003e,0x00000000,0x00050051,0x00000010,0x00000042,0x0000003e,0x00000001,0x00050051,
+		0x00000010,0x00000043,0x00000040,0x00000000,0x00050051,0x00000010,0x00000044,0x00000040,
+		0x00000001,0x00050085,0x00000010,0x00000045,0x00000041,0x00000043,0x00050085,0x00000010,
+		0x00000046,0x00000042,0x00000044,0x00050083,0x00000010,0x00000047,0x00000045,0x00000046,
+		0x00050085,0x00000010,0x00000048,0x00000041,0x00000044,0x00050085,0x00000010,0x00000049,
+		0x00000042,0x00000043,0x00050081,0x00000010,0x0000004a,0x00000048,0x00000049,0x00050050,
+		0x00000012,0x0000004b,0x00000047,0x0000004a,0x00050041,0x00000022,0x0000004c,0x0000000a,
+		0x00000015,0x0004003d,0x00000012,0x0000004d,0x0000004c,0x00050081,0x00000012,0x0000004e,
+		0x0000004b,0x0000004d,0x00050051,0x00000010,0x0000004f,0x0000004e,0x00000000,0x00050051,
+		0x00000010,0x00000050,0x0000004e,0x00000001,0x00070050,0x00000011,0x00000051,0x0000004f,
+		0x00000050,0x00000028,0x00000029,0x00050041,0x00000027,0x00000052,0x0000000d,0x00000015,
+		0x0004003d,0x00000025,0x00000053,0x00000052,0x00050091,0x00000011,0x00000054,0x00000053,
+		0x00000051,0x00050041,0x0000001d,0x00000055,0x00000007,0x00000015,0x0003003e,0x00000055,
+		0x00000054,0x00050041,0x00000020,0x00000056,0x00000007,0x00000016,0x0003003e,0x00000056,
+		0x00000029,0x000100fd,0x00010038
 	};
 
 	/**
@@ -160,7 +195,158 @@ namespace mlx
 		0x000100fd,0x00010038
 	};
 
-	void GraphicPipeline::init(Renderer& renderer)
+	/**
+			#version 450 core
+
+			layout(location = 0) out vec4 fColor;
+
+			layout(set = 1, binding = 0) uniform sampler2D sTileset;
+			layout(set = 2, binding = 0) uniform usampler2D sGrid;
+
+			layout(push_constant) uniform uTilemapPushConstant {
+				layout(offset = 64) ivec2 scroll;
+				ivec2 tile_size;
+				ivec2 tileset_origin;
+				ivec2 grid_size;
+				int tileset_columns;
+			} uMap;
+
+			layout(location = 0) in struct {
+				vec4 Color;
+				vec2 UV; // pixel position inside the drawn area
+			} In;
+
+			void main()
+			{
+				ivec2 pixel = ivec2(floor(In.UV)) + uMap.scroll;
+				ivec2 cell = pixel / uMap.tile_size;
+				if(any(lessThan(pixel, ivec2(0))) || any(greaterThanEqual(cell, uMap.grid_size)))
+					discard;
+				uint tile = texelFetch(sGrid, cell, 0).r;
+				if(tile == 0xFFFF) // empty cell
+					discard;
+				ivec2 texel = uMap.tileset_origin + ivec2(int(tile) % uMap.tileset_columns, int(tile) / uMap.tileset_columns) * uMap.tile_size + pixel % uMap.tile_size;
+				vec4 process_color = In.Color * texelFetch(sTileset, texel, 0);
+				if(process_color.w == 0)
+					discard;
+				fColor = process_color;
+			}
+	*/
+	const std::vector<std::uint32_t> tilemap_fragment_shader = {	// pre compiled tilemap fragment shader
+		0x07230203,0x00010000,0x0008000b,0x0000005b,0x00000000,0x00020011,0x00000001,0x0006000b,
+		0x00000001,0x4c534c47,0x6474732e,0x3035342e,0x00000000,0x0003000e,0x00000000,0x00000001,
+		0x0007000f,0x00000004,0x00000002,0x6e69616d,0x00000000,0x00000003,0x00000004,0x00030010,
+		0x00000002,0x00000007,0x00030003,0x00000002,0x000001c2,0x00040005,0x00000002,0x6e69616d,
+		0x00000000,0x00030005,0x00000005,0x00000000,0x00050006,0x00000005,0x00000000,0x6f6c6f43,
+		0x00000072,0x00040006,0x00000005,0x00000001,0x00005655,0x00030005,0x00000003,0x00006e49,
+		0x00080005,0x00000006,0x6c695475,0x70616d65,0x68737550,0x736e6f43,0x746e6174,0x00000000,
+		0x00050006,0x00000006,0x00000000,0x6f726373,0x00006c6c,0x00060006,0x00000006,0x00000001,
+		0x656c6974,0x7a69735f,0x00000065,0x00070006,0x00000006,0x00000002,0x656c6974,0x5f746573,
+		0x6769726f,0x00006e69,0x00060006,0x00000006,0x00000003,0x64697267,0x7a69735f,0x00000065,
+		0x00070006,0x00000006,0x00000004,0x656c6974,0x5f746573,0x756c6f63,0x00736e6d,0x00040005,
+		0x00000007,0x70614d75,0x00000000,0x00040005,0x00000008,0x69724773,0x00000064,0x00050005,
+		0x00000009,0x6c695473,0x74657365,0x00000000,0x00040005,0x00000004,0x6c6f4366,0x0000726f,
+		0x00040047,0x00000003,0x0000001e,0x00000000,0x00050048,0x00000006,0x00000000,0x00000023,
+		0x00000040,0x00050048,0x00000006,0x00000001,0x00000023,0x00000048,0x00050048,0x00000006,
+		0x00000002,0x00000023,0x00000050,0x00050048,0x00000006,0x00000003,0x00000023,0x00000058,
+		0x00050048,0x00000006,0x00000004,0x00000023,0x00000060,0x00030047,0x00000006,0x00000002,
+		0x00040047,0x00000008,0x00000022,0x00000002,0x00040047,0x00000008,0x00000021,0x00000000,
+		0x00040047,0x00000009,0x00000022,0x00000001,0x00040047,0x00000009,0x00000021,0x00000000,
+		0x00040047,0x00000004,0x0000001e,0x00000000,0x00020013,0x0000000a,0x00030021,0x0000000b,
+		0x0000000a,0x00030016,0x0000000c,0x00000020,0x00040017,0x0000000d,0x0000000c,0x00000004,
+		0x00040017,0x0000000e,0x0000000c,0x00000002,0x0004001e,0x00000005,0x0000000d,0x0000000e,
+		0x00040020,0x0000000f,0x00000001,0x00000005,0x0004003b,0x0000000f,0x00000003,0x00000001,
+		0x00040015,0x00000010,0x00000020,0x00000001,0x00040015,0x00000011,0x00000020,0x00000000,
+		0x00040017,0x00000012,0x00000010,0x00000002,0x00040017,0x00000013,0x00000011,0x00000004,
+		0x00020014,0x00000014,0x00040017,0x00000015,0x00000014,0x00000002,0x0004002b,0x00000010,
+		0x00000016,0x00000000,0x0004002b,0x00000010,0x00000017,0x00000001,0x0004002b,0x00000010,
+		0x00000018,0x00000002,0x0004002b,0x00000010,0x00000019,0x00000003,0x0004002b,0x00000010,
+		0x0000001a,0x00000004,0x0005002c,0x00000012,0x0000001b,0x00000016,0x00000016,0x0004002b,
+		0x00000011,0x0000001c,0x0000ffff,0x0004002b,0x0000000c,0x0000001d,0x00000000,0x00040020,
+		0x0000001e,0x00000001,0x0000000e,0x00040020,0x0000001f,0x00000001,0x0000000d,0x0007001e,
+		0x00000006,0x00000012,0x00000012,0x00000012,0x00000012,0x00000010,0x00040020,0x00000020,
+		0x00000009,0x00000006,0x0004003b,0x00000020,0x00000007,0x00000009,0x00040020,0x00000021,
+		0x00000009,0x00000012,0x00040020,0x00000022,0x00000009,0x00000010,0x00090019,0x00000023,
+		0x00000011,0x00000001,0x00000000,0x00000000,0x00000000,0x00000001,0x00000000,0x0003001b,
+		0x00000024,0x00000023,0x00040020,0x00000025,0x00000000,0x00000024,0x0004003b,0x00000025,
+		0x00000008,0x00000000,0x00090019,0x00000026,0x0000000c,0x00000001,0x00000000,0x00000000,
+		0x00000000,0x00000001,0x00000000,0x0003001b,0x00000027,0x00000026,0x00040020,0x00000028,
+		0x00000000,0x00000027,0x0004003b,0x00000028,0x00000009,0x00000000,0x00040020,0x00000029,
+		0x00000003,0x0000000d,0x0004003b,0x00000029,0x00000004,0x00000003,0x00050036,0x0000000a,
+		0x00000002,0x00000000,0x0000000b,0x000200f8,0x0000002a,0x00050041,0x0000001e,0x0000002b,
+		0x00000003,0x00000017,0x0004003d,0x0000000e,0x0000002c,0x0000002b,0x0006000c,0x0000000e,
+		0x0000002d,0x00000001,0x00000008,0x0000002c,0x0004006e,0x00000012,0x0000002e,0x0000002d,
+		0x00050041,0x00000021,0x0000002f,0x00000007,0x00000016,0x0004003d,0x00000012,0x00000030,
+		0x0000002f,0x00050080,0x00000012,0x00000031,0x0000002e,0x00000030,0x00050041,0x00000021,
+		0x00000032,0x00000007,0x00000017,0x0004003d,0x00000012,0x00000033,0x00000032,0x00050087,
+		0x00000012,0x00000034,0x00000031,0x00000033,0x00050041,0x00000021,0x00000035,0x00000007,
+		0x00000019,0x0004003d,0x00000012,0x00000036,0x00000035,0x000500b1,0x00000015,0x00000037,
+		0x00000031,0x0000001b,0x0004009a,0x00000014,0x00000038,0x00000037,0x000500af,0x00000015,
+		0x00000039,0x00000034,0x00000036,0x0004009a,0x00000014,0x0000003a,0x00000039,0x000500a6,
+		0x00000014,0x0000003b,0x00000038,0x0000003a,0x000300f7,0x0000003c,0x00000000,0x000400fa,
+		0x0000003b,0x0000003d,0x0000003c,0x000200f8,0x0000003d,0x000100fc,0x000200f8,0x0000003c,
+		0x0004003d,0x00000024,0x0000003e,0x00000008,0x00040064,0x00000023,0x0000003f,0x0000003e,
+		0x0007005f,0x00000013,0x00000040,0x0000003f,0x00000034,0x00000002,0x00000016,0x00050051,
+		0x00000011,0x00000041,0x00000040,0x00000000,0x000500aa,0x00000014,0x00000042,0x00000041,
+		0x0000001c,0x000300f7,0x00000043,0x00000000,0x000400fa,0x00000042,0x00000044,0x00000043,
+		0x000200f8,0x00000044,0x000100fc,0x000200f8,0x00000043,0x0004007c,0x00000010,0x00000045,
+		0x00000041,0x00050041,0x00000022,0x00000046,0x00000007,0x0000001a,0x0004003d,0x00000010,
+		0x00000047,0x00000046,0x0005008b,0x00000010,0x00000048,0x00000045,0x00000047,0x00050087,
+		0x00000010,0x00000049,0x00000045,0x00000047,0x00050050,0x00000012,0x0000004a,0x00000048,
+		0x00000049,0x00050084,0x00000012,0x0000004b,0x0000004a,0x00000033,0x0005008b,0x00000012,
+		0x0000004c,0x00000031,0x00000033,0x00050041,0x00000021,0x0000004d,0x00000007,0x00000018,
+		0x0004003d,0x00000012,0x0000004e,0x0000004d,0x00050080,0x00000012,0x0000004f,0x0000004e,
+		0x0000004b,0x00050080,0x00000012,0x00000050,0x0000004f,0x0000004c,0x0004003d,0x00000027,
+		0x00000051,0x00000009,0x00040064,0x00000026,0x00000052,0x00000051,0x0007005f,0x0000000d,
+		0x00000053,0x00000052,0x00000050,0x00000002,0x00000016,0x00050041,0x0000001f,0x00000054,
+		0x00000003,0x00000016,0x0004003d,0x0000000d,0x00000055,0x00000054,0x00050085,0x0000000d,
+		0x00000056,0x00000055,0x00000053,0x00050051,0x0000000c,0x00000057,0x00000056,0x00000003,
+		0x000500b4,0x00000014,0x00000058,0x00000057,0x0000001d,0x000300f7,0x00000059,0x00000000,
+		0x000400fa,0x00000058,0x0000005a,0x00000059,0x000200f8,0x0000005a,0x000100fc,0x000200f8,
+		0x00000059,0x0003003e,0x00000004,0x00000056,0x000100fd,0x00010038
+	};
+
+	/**
+			#version 450 core
+
+			layout(location = 0) out vec4 fColor;
+
+			layout(location = 0) in struct {
+				vec4 Color;
+				vec2 UV;
+			} In;
+
+			void main()
+			{
+				if(In.Color.w == 0)
+					discard;
+				fColor = In.Color;
+			}
+	*/
+	const std::vector<std::uint32_t> color_fragment_shader = {	// pre compiled untextured fragment shader
+		0x07230203,0x00010000,0x0008000b,0x00000019,0x00000000,0x00020011,0x00000001,0x0006000b,
+		0x00000001,0x4c534c47,0x6474732e,0x3035342e,0x00000000,0x0003000e,0x00000000,0x00000001,
+		0x0007000f,0x00000004,0x00000002,0x6e69616d,0x00000000,0x00000003,0x00000004,0x00030010,
+		0x00000002,0x00000007,0x00030003,0x00000002,0x000001c2,0x00040005,0x00000002,0x6e69616d,
+		0x00000000,0x00030005,0x00000005,0x00000000,0x00050006,0x00000005,0x00000000,0x6f6c6f43,
+		0x00000072,0x00040006,0x00000005,0x00000001,0x00005655,0x00030005,0x00000003,0x00006e49,
+		0x00040005,0x00000004,0x6c6f4366,0x0000726f,0x00040047,0x00000003,0x0000001e,0x00000000,
+		0x00040047,0x00000004,0x0000001e,0x00000000,0x00020013,0x00000006,0x00030021,0x00000007,
+		0x00000006,0x00030016,0x00000008,0x00000020,0x00040017,0x00000009,0x00000008,0x00000004,
+		0x00040017,0x0000000a,0x00000008,0x00000002,0x0004001e,0x00000005,0x00000009,0x0000000a,
+		0x00040020,0x0000000b,0x00000001,0x00000005,0x0004003b,0x0000000b,0x00000003,0x00000001,
+		0x00040015,0x0000000c,0x00000020,0x00000001,0x0004002b,0x0000000c,0x0000000d,0x00000000,
+		0x00020014,0x0000000e,0x0004002b,0x00000008,0x0000000f,0x00000000,0x00040020,0x00000010,
+		0x00000001,0x00000009,0x00040020,0x00000011,0x00000003,0x00000009,0x0004003b,0x00000011,
+		0x00000004,0x00000003,0x00050036,0x00000006,0x00000002,0x00000000,0x00000007,0x000200f8,
+		0x00000012,0x00050041,0x00000010,0x00000013,0x00000003,0x0000000d,0x0004003d,0x00000009,
+		0x00000014,0x00000013,0x00050051,0x00000008,0x00000015,0x00000014,0x00000003,0x000500b4,
+		0x0000000e,0x00000016,0x00000015,0x0000000f,0x000300f7,0x00000017,0x00000000,0x000400fa,
+		0x00000016,0x00000018,0x00000017,0x000200f8,0x00000018,0x000100fc,0x000200f8,0x00000017,
+		0x0003003e,0x00000004,0x00000014,0x000100fd,0x00010038
+	};
+
+	void GraphicPipeline::init(Renderer& renderer, kind type)
     {
 		VkShaderModuleCreateInfo createInfo{};
 		createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
@@ -170,14 +356,23 @@ namespace mlx
 		if(vkCreateShaderModule(Render_Core::get().getDevice().get(), &createInfo, nullptr, &vshader) != VK_SUCCESS)
 			core::error::report(e_kind::fatal_error, "Vulkan : failed to create a vertex shader module");
 
-		VkPushConstantRange push_constant;
-		push_constant.offset = 0;
-		push_constant.size = sizeof(glm::vec2);
-		push_constant.stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
-
+		// every pipeline declares the same ranges so that switching between them keeps the bound sets valid
+		std::array<VkPushConstantRange, 2> push_constants;
+		push_constants[0].offset = 0;
+		push_constants[0].size = sizeof(ModelPushConstant);
+		push_constants[0].stageFlags = VK_SHADER_STAGE_VERTEX_BIT;
+		push_constants[1].offset = sizeof(ModelPushConstant);
+		push_constants[1].size = sizeof(TilemapPushConstant);
+		push_constants[1].stageFlags = VK_SHADER_STAGE_FRAGMENT_BIT;
+
+		const std::vector<std::uint32_t>* fragment_code = &fragment_shader;
+		if(type == kind::tilemap)
+			fragment_code = &tilemap_fragment_shader;
+		else if(type == kind::points || type == kind::shapes)
+			fragment_code = &color_fragment_shader;
 		createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-		createInfo.codeSize = fragment_shader.size() * sizeof(std::uint32_t);
-		createInfo.pCode = fragment_shader.data();
+		createInfo.codeSize = fragment_code->size() * sizeof(std::uint32_t);
+		createInfo.pCode = fragment_code->data();
 		VkShaderModule fshader;
 		if(vkCreateShaderModule(Render_Core::get().getDevice().get(), &createInfo, nullptr, &fshader) != VK_SUCCESS)
 			core::error::report(e_kind::fatal_error, "Vulkan : failed to create a fragment shader module");
@@ -208,7 +403,7 @@ namespace mlx
 
 		VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
 		inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
-		inputAssembly.topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+		inputAssembly.topology = (type == kind::points ? VK_PRIMITIVE_TOPOLOGY_POINT_LIST : VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST);
 		inputAssembly.primitiveRestartEnable = VK_FALSE;
 
 		VkDynamicState states[] = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
@@ -276,15 +471,16 @@ namespace mlx
 
 		VkDescriptorSetLayout layouts[] = {
 			renderer.getVertDescriptorSetLayout().get(),
-			renderer.getFragDescriptorSetLayout().get()
+			renderer.getFragDescriptorSetLayout().get(),
+			renderer.getFragDescriptorSetLayout().get() // tilemap grid
 		};
 
 		VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
 		pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
-		pipelineLayoutInfo.setLayoutCount = 2;
+		pipelineLayoutInfo.setLayoutCount = (type == kind::tilemap ? 3 : 2);
 		pipelineLayoutInfo.pSetLayouts = layouts;
-		pipelineLayoutInfo.pushConstantRangeCount = 1;
-		pipelineLayoutInfo.pPushConstantRanges = &push_constant;
+		pipelineLayoutInfo.pushConstantRangeCount = push_constants.size();
+		pipelineLayoutInfo.pPushConstantRanges = push_constants.data();
 
 		if(vkCreatePipelineLayout(Render_Core::get().getDevice().get(), &pipelineLayoutInfo, nullptr, &_pipeline_layout) != VK_SUCCESS)
 			core::error::report(e_kind::fatal_error, "Vulkan : failed to create a graphics pipeline layout");
@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/12/18 21:23:52 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/14 17:04:28 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 04:09:37 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -15,14 +15,39 @@
 
 #include <mlx_profile.h>
 #include <volk.h>
+#include <glm/glm.hpp>
 #include <renderer/command/vk_cmd_buffer.h>
 
 namespace mlx
 {
+	struct ModelPushConstant // must match uModelPushConstant in the vertex shader
+	{
+		glm::vec2 translate;
+		glm::vec2 scale = { 1.f, 1.f };
+		glm::vec2 uv_offset = { 0.f, 0.f };
+		glm::vec2 uv_scale = { 1.f, 1.f };
+		glm::vec4 tint = { 1.f, 1.f, 1.f, 1.f };
+		glm::vec2 origin = { 0.f, 0.f }; // moves the scaled quad before it is rotated
+		glm::vec2 rotation = { 1.f, 0.f }; // cosine and sine of the angle
+
+		ModelPushConstant(glm::vec2 _translate) : translate(std::move(_translate)) {}
+	};
+
+	struct TilemapPushConstant // must match uTilemapPushConstant in the tilemap fragment shader, pushed right after the model
+	{
+		glm::ivec2 scroll;
+		glm::ivec2 tile_size;
+		glm::ivec2 tileset_origin;
+		glm::ivec2 grid_size;
+		std::int32_t tileset_columns;
+	};
+
 	class GraphicPipeline
 	{
 		public:
-			void init(class Renderer& renderer);
+			enum class kind { textured, tilemap, points, shapes }; // tilemaps read their grid from an extra fragment set, points and shapes are untextured
+
+			void init(class Renderer& renderer, kind type = kind::textured);
 			void destroy() noexcept;
 
 			inline void bindPipeline(CmdBuffer& command_buffer) noexcept { vkCmdBindPipeline(command_buffer.get(), VK_PIPELINE_BIND_POINT_GRAPHICS, _graphics_pipeline); }
@@ -6,12 +6,14 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/03/31 15:14:50 by maldavid          #+#    #+#             */
-/*   Updated: 2024/01/11 00:06:01 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 03:59:12 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include <renderer/pixel_put.h>
+#include <renderer/core/render_core.h>
 #include <cstring>
+#include <algorithm>
 #include <core/profiler.h>
 
 namespace mlx
@@ -27,40 +29,249 @@ namespace mlx
 		_cpu_map = std::vector<std::uint32_t>(height * width + 1, 0);
 		_width = width;
 		_height = height;
+		_modified_area = { { 0, 0 }, { width, height } };
+		_upload_area = { { 0, 0 }, { 0, 0 } }; // the texture was created cleared like the CPU map
+		_written_area = { { 0, 0 }, { 0, 0 } };
+		_pending_scroll = { 0, 0 };
+		_pending_clear = false;
+		_is_texture_clear = true;
 	}
 
 	void PixelPutPipeline::setPixel(int x, int y, std::uint32_t color) noexcept
 	{
 		MLX_PROFILE_FUNCTION();
-		if(x < 0 || y < 0 || x > static_cast<int>(_width) || y > static_cast<int>(_height))
+		if(x < 0 || y < 0 || x >= static_cast<int>(_width) || y >= static_cast<int>(_height))
+			return;
+		if(_cpu_map[(y * _width) + x] == color)
 			return;
 		_cpu_map[(y * _width) + x] = color;
+		_modified_area = rectUnion(_modified_area, { { x, y }, { 1, 1 } });
+		_written_area = rectUnion(_written_area, { { x, y }, { 1, 1 } });
 		_has_been_modified = true;
+		// a point replaces what the texture shows only if it is opaque
+		if((color >> 24) == 0xFF && _points.size() < SPARSE_PUTS_THRESHOLD && rectIsEmpty(_upload_area))
+		{
+			glm::vec4 rgba(color & 0xFF, (color >> 8) & 0xFF, (color >> 16) & 0xFF, 0xFF);
+			_points.emplace_back(glm::vec2(x + 0.5f, y + 0.5f), rgba / 255.f, glm::vec2(0.f, 0.f));
+			_points_version++;
+			return;
+		}
+		foldPoints();
+		_upload_area = rectUnion(_upload_area, { { x, y }, { 1, 1 } });
 	}
 
-	void PixelPutPipeline::clear()
+	void PixelPutPipeline::foldPoints() noexcept
+	{
+		if(_points.empty())
+			return;
+		for(const Vertex& point : _points)
+			_upload_area = rectUnion(_upload_area, { { static_cast<std::int32_t>(point.pos.x), static_cast<std::int32_t>(point.pos.y) }, { 1, 1 } });
+		_points.clear();
+		_points_version++;
+	}
+
+	void PixelPutPipeline::scroll(int dx, int dy, std::uint32_t fill) noexcept
 	{
 		MLX_PROFILE_FUNCTION();
-		_cpu_map.assign(_width * _height, 0);
+		if(dx == 0 && dy == 0)
+			return;
+		foldPoints(); // moved with the CPU map
+		VkRect2D full = { { 0, 0 }, { _width, _height } };
+		_modified_area = full; // everything moves on the window
+		_has_been_modified = true;
+		VkRect2D kept = rectIntersection({ { dx, dy }, { _width, _height } }, full); // where the pixels still shown land
+		if(rectIsEmpty(kept))
+		{
+			std::fill(_cpu_map.begin(), _cpu_map.begin() + static_cast<std::size_t>(_width) * _height, fill);
+			_upload_area = full;
+			_written_area = (fill != 0 ? full : VkRect2D{ { 0, 0 }, { 0, 0 } });
+			_pending_scroll = { 0, 0 };
+			return;
+		}
+
+		std::uint32_t* map = _cpu_map.data();
+		if(dy != 0)
+			std::memmove(map + static_cast<std::size_t>(kept.offset.y) * _width, map + static_cast<std::size_t>(kept.offset.y - dy) * _width, sizeof(std::uint32_t) * kept.extent.height * _width);
+		std::uint32_t kept_y1 = kept.offset.y + kept.extent.height;
+		std::uint32_t kept_x1 = kept.offset.x + kept.extent.width;
+		for(std::uint32_t y = 0; y < _height; y++)
+		{
+			std::uint32_t* row = map + static_cast<std::size_t>(y) * _width;
+			if(y < static_cast<std::uint32_t>(kept.offset.y) || y >= kept_y1)
+			{
+				std::fill(row, row + _width, fill);
+				continue;
+			}
+			if(dx == 0)
+				continue;
+			std::memmove(row + kept.offset.x, row + kept.offset.x - dx, sizeof(std::uint32_t) * kept.extent.width);
+			std::fill(row, row + kept.offset.x, fill);
+			std::fill(row + kept_x1, row + _width, fill);
+		}
+
+		// pixels modified since the last upload moved with the others, the exposed bands have to be uploaded too
+		VkRect2D moved = _upload_area;
+		moved.offset.x += dx;
+		moved.offset.y += dy;
+		_upload_area = rectIntersection(moved, full);
+		if(kept.extent.height != _height)
+			_upload_area = rectUnion(_upload_area, { { 0, dy > 0 ? 0 : static_cast<std::int32_t>(kept_y1) }, { _width, _height - kept.extent.height } });
+		if(kept.extent.width != _width)
+			_upload_area = rectUnion(_upload_area, { { dx > 0 ? 0 : static_cast<std::int32_t>(kept_x1), 0 }, { _width - kept.extent.width, _height } });
+		_pending_scroll.x += dx;
+		_pending_scroll.y += dy;
+		if(fill != 0)
+			_written_area = full;
+		else
+			_written_area = rectIntersection({ { _written_area.offset.x + dx, _written_area.offset.y + dy }, _written_area.extent }, full);
+	}
+
+	void PixelPutPipeline::markModified(VkRect2D area) noexcept
+	{
+		if(rectIsEmpty(area))
+			return;
+		foldPoints(); // the area may overwrite some of them
+		_modified_area = rectUnion(_modified_area, area);
+		_upload_area = rectUnion(_upload_area, area);
+		_written_area = rectUnion(_written_area, area);
 		_has_been_modified = true;
 	}
 
-	void PixelPutPipeline::render(std::array<VkDescriptorSet, 2>& sets, Renderer& renderer) noexcept
+	void PixelPutPipeline::clear()
+	{
+		MLX_PROFILE_FUNCTION();
+		// only the written pixels are zeroed, the texture is cleared by the GPU instead of being uploaded again
+		VkRect2D written = rectIntersection(_written_area, { { 0, 0 }, { _width, _height } });
+		for(std::uint32_t y = 0; y < written.extent.height; y++)
+		{
+			std::uint32_t* row = _cpu_map.data() + static_cast<std::size_t>(written.offset.y + y) * _width + written.offset.x;
+			std::fill(row, row + written.extent.width, 0);
+		}
+		_modified_area = rectUnion(_modified_area, written);
+		_upload_area = { { 0, 0 }, { 0, 0 } };
+		_written_area = { { 0, 0 }, { 0, 0 } };
+		_pending_scroll = { 0, 0 }; // shifting a cleared texture changes nothing
+		if(!_points.empty())
+		{
+			_points.clear();
+			_points_version++;
+		}
+		if(!_is_texture_clear)
+			_pending_clear = true;
+		_has_been_modified |= _pending_clear || !rectIsEmpty(written);
+	}
+
+	void PixelPutPipeline::render(std::array<VkDescriptorSet, 2>& sets, Renderer& renderer, int x, int y, float scale) noexcept
 	{
 		MLX_PROFILE_FUNCTION();
 		if(_has_been_modified)
 		{
-			std::memcpy(_buffer_map, _cpu_map.data(), sizeof(std::uint32_t) * _cpu_map.size());
-			_texture.copyFromBuffer(_buffer);
+			// the texture keeps the previous content, only the rows of the area it misses need to be copied
+			VkRect2D area = rectIntersection(_upload_area, { { 0, 0 }, { _width, _height } });
+			bool shift = (_pending_scroll.x != 0 || _pending_scroll.y != 0) && !_is_texture_clear && !_pending_clear;
+			if(_pending_clear || shift || !rectIsEmpty(area)) // all the transfers share a single submission
+			{
+				CmdBuffer& cmd = Render_Core::get().getSingleTimeCmdBuffer();
+				cmd.beginRecord();
+				VkImageLayout layout_save = _texture.getLayout();
+				if(_pending_clear)
+				{
+					_texture.transitionLayout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &cmd);
+					cmd.clearColorImage(_texture, VkClearColorValue{ { 0.f, 0.f, 0.f, 0.f } });
+					_is_texture_clear = true;
+				}
+				if(shift)
+					shiftImage(cmd);
+				if(!rectIsEmpty(area))
+				{
+					std::size_t offset = static_cast<std::size_t>(area.offset.y) * _width;
+					std::size_t size = static_cast<std::size_t>(area.extent.height) * _width;
+					std::memcpy(static_cast<std::uint32_t*>(_buffer_map) + offset, _cpu_map.data() + offset, sizeof(std::uint32_t) * size);
+					if(_pending_clear || shift) // the texture may already be in transfer dst layout, without any barrier left
+						cmd.transferBarrier();
+					_texture.copyFromBuffer(_buffer, area, &cmd);
+					_is_texture_clear = false;
+				}
+				_texture.transitionLayout(layout_save, &cmd);
+				cmd.endRecord();
+				cmd.submitIdle();
+				_pending_clear = false;
+			}
+			_pending_scroll = { 0, 0 };
+			_modified_area = { { 0, 0 }, { 0, 0 } };
+			_upload_area = { { 0, 0 }, { 0, 0 } };
 			_has_been_modified = false;
 		}
 		_texture.updateSet(0);
-		_texture.render(sets, renderer, 0, 0);
+		ImageTransform transform;
+		transform.scale = { scale, scale };
+		_texture.render(sets, renderer, x, y, {}, transform);
+		if(!_points.empty())
+			renderPoints(sets, renderer, x, y, scale);
+	}
+
+	void PixelPutPipeline::renderPoints(std::array<VkDescriptorSet, 2>& sets, Renderer& renderer, int x, int y, float scale)
+	{
+		MLX_PROFILE_FUNCTION();
+		if(_points_vbos.empty())
+		{
+			_points_vbos.resize(renderer.getFramesInFlight());
+			for(VBO& vbo : _points_vbos)
+				vbo.create(sizeof(Vertex) * SPARSE_PUTS_THRESHOLD, nullptr, "__mlx_pixel_put_pipeline_points");
+			_points_vbos_versions.assign(_points_vbos.size(), _points_version - 1);
+		}
+		// the buffer of the frame being recorded is not read by the ones still in flight
+		std::uint32_t frame = renderer.getActiveImageIndex();
+		if(_points_vbos_versions[frame] != _points_version)
+		{
+			_points_vbos[frame].setData(sizeof(Vertex) * _points.size(), _points.data());
+			_points_vbos_versions[frame] = _points_version;
+		}
+
+		ModelPushConstant model(glm::vec2(x, y));
+		model.scale = glm::vec2(scale, scale);
+
+		CmdBuffer& cmd = renderer.getActiveCmdBuffer();
+		GraphicPipeline& pipeline = renderer.getPointsPipeline();
+		pipeline.bindPipeline(cmd);
+		_points_vbos[frame].bind(renderer);
+		vkCmdPushConstants(cmd.get(), pipeline.getPipelineLayout(), VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(model), &model);
+		vkCmdBindDescriptorSets(cmd.get(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline.getPipelineLayout(), 0, 1, &sets[0], 0, nullptr);
+		vkCmdDraw(cmd.get(), static_cast<std::uint32_t>(_points.size()), 1, 0, 0);
+		renderer.getPipeline().bindPipeline(cmd); // the following resources expect the textured pipeline
+	}
+
+	void PixelPutPipeline::shiftImage(CmdBuffer& cmd)
+	{
+		MLX_PROFILE_FUNCTION();
+		VkRect2D full = { { 0, 0 }, { _width, _height } };
+		VkRect2D dst = rectIntersection({ _pending_scroll, { _width, _height } }, full);
+		VkRect2D src = { { dst.offset.x - _pending_scroll.x, dst.offset.y - _pending_scroll.y }, dst.extent };
+		_pending_scroll = { 0, 0 };
+		VkRect2D uploaded = rectIntersection(_upload_area, full);
+		if(rectIsEmpty(dst) || (uploaded.extent.width == _width && uploaded.extent.height == _height)) // nothing would be kept
+			return;
+		if(!_scroll_scratch.isInit())
+			_scroll_scratch.create(_width, _height, VK_FORMAT_R8G8B8A8_UNORM, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT, "__mlx_pixel_put_pipeline_scroll_scratch");
+
+		_scroll_scratch.discardContent();
+		_texture.transitionLayout(VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, &cmd);
+		_scroll_scratch.transitionLayout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &cmd);
+		cmd.copyImageToImage(_texture, _scroll_scratch, src, dst.offset);
+		_scroll_scratch.transitionLayout(VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, &cmd);
+		_texture.transitionLayout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &cmd);
+		cmd.copyImageToImage(_scroll_scratch, _texture, dst);
 	}
 
 	void PixelPutPipeline::destroy() noexcept
 	{
 		MLX_PROFILE_FUNCTION();
+		if(_scroll_scratch.isInit())
+			_scroll_scratch.destroy();
+		for(VBO& vbo : _points_vbos)
+			vbo.destroy();
+		_points_vbos.clear();
+		_points.clear();
 		_buffer.destroy();
 		_texture.destroy();
 	}
@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/03/31 13:18:50 by maldavid          #+#    #+#             */
-/*   Updated: 2024/01/11 00:06:05 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 03:59:12 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -16,33 +16,68 @@
 #include <mlx_profile.h>
 #include <renderer/images/texture.h>
 #include <renderer/descriptors/vk_descriptor_set.h>
+#include <utils/rect.h>
 
 namespace mlx
 {
 	class PixelPutPipeline
 	{
 		public:
+			// opaque pixels put since the last upload are drawn as points until there are more than this
+			static constexpr std::size_t SPARSE_PUTS_THRESHOLD = 2048;
+
 			PixelPutPipeline() = default;
 
 			void init(std::uint32_t width, std::uint32_t height, class Renderer& renderer) noexcept;
 
 			void setPixel(int x, int y, std::uint32_t color) noexcept;
-			void render(std::array<VkDescriptorSet, 2>& sets, class Renderer& renderer) noexcept;
+			void scroll(int dx, int dy, std::uint32_t fill) noexcept; // moves the pixels, the exposed ones are set to `fill`
+			void render(std::array<VkDescriptorSet, 2>& sets, class Renderer& renderer, int x = 0, int y = 0, float scale = 1.f) noexcept;
 
 			void clear();
 			void destroy() noexcept;
 
+			inline bool hasBeenModified() const noexcept { return _has_been_modified; }
+			inline VkRect2D getModifiedArea() const noexcept { return _modified_area; } // what changed since the last render
+			void markModified(VkRect2D area) noexcept; // to call after writing directly in the CPU map
+
+			inline std::uint32_t* getCPUMap() noexcept { return _cpu_map.data(); }
+			inline std::uint32_t getWidth() const noexcept { return _width; }
+			inline std::uint32_t getHeight() const noexcept { return _height; }
+
 			~PixelPutPipeline();
 
+		private:
+			void shiftImage(CmdBuffer& cmd);
+			void foldPoints() noexcept; // sends the points through the texture upload instead
+			void renderPoints(std::array<VkDescriptorSet, 2>& sets, class Renderer& renderer, int x, int y, float scale);
+
 		private:
 			Texture _texture;
+			Image _scroll_scratch; // vkCmdCopyImage cannot copy between overlapping areas of an image
 			Buffer _buffer;
 			// using vector as CPU map and not directly writting to mapped buffer to improve performances
 			std::vector<std::uint32_t> _cpu_map;
+			std::vector<Vertex> _points; // already in the CPU map but not in the texture
+			std::vector<VBO> _points_vbos; // one per frame in flight
+			std::vector<std::uint64_t> _points_vbos_versions;
+			std::uint64_t _points_version = 0;
 			void* _buffer_map = nullptr;
+			VkRect2D _modified_area = { { 0, 0 }, { 0, 0 } };
+			VkRect2D _upload_area = { { 0, 0 }, { 0, 0 } }; // what the texture misses once shifted, smaller than the modified area after a scroll
+			VkRect2D _written_area = { { 0, 0 }, { 0, 0 } }; // outside of it the CPU map is known to be zeroed
+			VkOffset2D _pending_scroll = { 0, 0 }; // shift of the texture content not done yet
 			std::uint32_t _width = 0;
 			std::uint32_t _height = 0;
 			bool _has_been_modified = true;
+			bool _pending_clear = false; // the texture is cleared by the GPU before the next upload
+			bool _is_texture_clear = true; // nothing was uploaded since the last GPU clear
+	};
+
+	struct PixelLayer // pixels put apart from the window ones, uploaded only when its own pixels change
+	{
+		PixelPutPipeline pipeline;
+		int z = 0; // negative layers are drawn under the puts, the others over the window pixels
 	};
 }
 
@@ -0,0 +1,230 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   frame_recorder.cpp                                 :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 02:37:19 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/19 02:37:19 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <renderer/recorder/frame_recorder.h>
+#include <renderer/command/vk_cmd_buffer.h>
+#include <renderer/images/vk_image.h>
+#include <core/errors.h>
+#include <core/profiler.h>
+#include <string>
+
+namespace mlx
+{
+	bool FrameRecorder::start(const std::filesystem::path& filepath, std::uint32_t width, std::uint32_t height, VkFormat image_format, std::size_t slots_count, std::uint32_t fps)
+	{
+		MLX_PROFILE_FUNCTION();
+		if(_is_recording)
+		{
+			core::error::report(e_kind::error, "Frame recorder : already recording");
+			return false;
+		}
+
+		switch(image_format)
+		{
+			case VK_FORMAT_R8G8B8A8_UNORM:
+			case VK_FORMAT_R8G8B8A8_SRGB: _swap_red_blue = false; break;
+			case VK_FORMAT_B8G8R8A8_UNORM:
+			case VK_FORMAT_B8G8R8A8_SRGB: _swap_red_blue = true; break;
+
+			default:
+				core::error::report(e_kind::error, "Frame recorder : unsupported image format, cannot record");
+				return false;
+		}
+
+		_file.open(filepath, std::ios::binary | std::ios::trunc);
+		if(!_file.is_open())
+		{
+			core::error::report(e_kind::error, "Frame recorder : unable to open '%s'", filepath.string().c_str());
+			return false;
+		}
+
+		_width = width;
+		_height = height;
+		_format = (filepath.extension() == ".y4m" ? format::y4m : format::raw_rgba);
+		if(_format == format::y4m)
+		{
+			// 4:4:4 so we do not have to deal with chroma subsampling for odd sizes
+			std::string header = "YUV4MPEG2 W" + std::to_string(width) + " H" + std::to_string(height) + " F" + std::to_string(fps) + ":1 Ip A1:1 C444\n";
+			_file.write(header.data(), header.size());
+			_conversion_buffer.resize(static_cast<std::size_t>(width) * height * 3);
+		}
+		else if(_swap_red_blue)
+			_conversion_buffer.resize(static_cast<std::size_t>(width) * height * 4);
+
+		_slots = std::vector<Slot>(slots_count);
+		for(Slot& slot : _slots)
+		{
+			#ifdef DEBUG
+				slot.buffer.create(Buffer::kind::readback, static_cast<VkDeviceSize>(width) * height * 4, VK_BUFFER_USAGE_TRANSFER_DST_BIT, "__mlx_frame_recorder_slot");
+			#else
+				slot.buffer.create(Buffer::kind::readback, static_cast<VkDeviceSize>(width) * height * 4, VK_BUFFER_USAGE_TRANSFER_DST_BIT, nullptr);
+			#endif
+			slot.buffer.mapMem(reinterpret_cast<void**>(&slot.map));
+		}
+
+		_next_slot = 0;
+		_recorded_frames = 0;
+		_dropped_frames = 0;
+		_should_stop = false;
+		_is_recording = true;
+		_writer = std::thread(&FrameRecorder::writerLoop, this);
+		return true;
+	}
+
+	void FrameRecorder::capture(CmdBuffer& cmd, Image& image) noexcept
+	{
+		MLX_PROFILE_FUNCTION();
+		if(!_is_recording)
+			return;
+		if(image.getWidth() != _width || image.getHeight() != _height)
+		{
+			if(_dropped_frames++ == 0)
+				core::error::report(e_kind::warning, "Frame recorder : the recorded image has been resized, frames will be dropped until its original size is restored");
+			return;
+		}
+
+		Slot& slot = _slots[_next_slot];
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			if(slot.state != slot_state::free) // the writer thread is late, we drop the frame instead of stalling the renderer
+			{
+				_dropped_frames++;
+				return;
+			}
+			slot.state = slot_state::in_flight;
+		}
+		slot.cmd = &cmd;
+
+		VkImageLayout layout_save = image.getLayout();
+		image.transitionLayout(VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, &cmd);
+		cmd.copyImagetoBuffer(image, slot.buffer);
+		image.transitionLayout(layout_save, &cmd);
+
+		_next_slot = (_next_slot + 1) % _slots.size();
+	}
+
+	void FrameRecorder::onFrameCompleted(CmdBuffer& cmd) noexcept
+	{
+		MLX_PROFILE_FUNCTION();
+		if(!_is_recording)
+			return;
+		bool notify = false;
+		for(std::size_t i = 0; i < _slots.size(); i++)
+		{
+			if(_slots[i].cmd != &cmd || _slots[i].state != slot_state::in_flight)
+				continue;
+			_slots[i].buffer.invalidate();
+			_slots[i].cmd = nullptr;
+			std::unique_lock<std::mutex> lock(_mutex);
+			_slots[i].state = slot_state::ready;
+			_ready_slots.push_back(i);
+			notify = true;
+		}
+		if(notify)
+			_cv.notify_one();
+	}
+
+	void FrameRecorder::writerLoop()
+	{
+		for(;;)
+		{
+			std::size_t index = 0;
+			{
+				std::unique_lock<std::mutex> lock(_mutex);
+				_cv.wait(lock, [this]() { return _should_stop || !_ready_slots.empty(); });
+				if(_ready_slots.empty()) // stop has been requested and every pending frame has been written
+					return;
+				index = _ready_slots.front();
+				_ready_slots.pop_front();
+			}
+			writeFrame(_slots[index].map);
+			{
+				std::unique_lock<std::mutex> lock(_mutex);
+				_slots[index].state = slot_state::free;
+			}
+			_recorded_frames++;
+		}
+	}
+
+	void FrameRecorder::writeFrame(const std::uint8_t* pixels)
+	{
+		const std::size_t pixels_count = static_cast<std::size_t>(_width) * _height;
+		if(_format == format::raw_rgba)
+		{
+			if(!_swap_red_blue)
+			{
+				_file.write(reinterpret_cast<const char*>(pixels), pixels_count * 4);
+				return;
+			}
+			for(std::size_t i = 0; i < pixels_count * 4; i += 4)
+			{
+				_conversion_buffer[i + 0] = pixels[i + 2];
+				_conversion_buffer[i + 1] = pixels[i + 1];
+				_conversion_buffer[i + 2] = pixels[i + 0];
+				_conversion_buffer[i + 3] = pixels[i + 3];
+			}
+			_file.write(reinterpret_cast<const char*>(_conversion_buffer.data()), _conversion_buffer.size());
+			return;
+		}
+
+		// BT.601 studio range conversion, planes are stored one after the other
+		std::uint8_t* y_plane = _conversion_buffer.data();
+		std::uint8_t* u_plane = y_plane + pixels_count;
+		std::uint8_t* v_plane = u_plane + pixels_count;
+		const int r_index = (_swap_red_blue ? 2 : 0);
+		const int b_index = (_swap_red_blue ? 0 : 2);
+		for(std::size_t i = 0; i < pixels_count; i++)
+		{
+			const int r = pixels[i * 4 + r_index];
+			const int g = pixels[i * 4 + 1];
+			const int b = pixels[i * 4 + b_index];
+			y_plane[i] = static_cast<std::uint8_t>(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+			u_plane[i] = static_cast<std::uint8_t>(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+			v_plane[i] = static_cast<std::uint8_t>(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+		}
+		_file.write("FRAME\n", 6);
+		_file.write(reinterpret_cast<const char*>(_conversion_buffer.data()), _conversion_buffer.size());
+	}
+
+	void FrameRecorder::stop() noexcept
+	{
+		MLX_PROFILE_FUNCTION();
+		if(!_is_recording)
+			return;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_should_stop = true;
+		}
+		_cv.notify_one();
+		if(_writer.joinable())
+			_writer.join();
+
+		for(Slot& slot : _slots)
+			slot.buffer.destroy();
+		_slots.clear();
+		_ready_slots.clear();
+		_conversion_buffer.clear();
+		_conversion_buffer.shrink_to_fit();
+		_file.close();
+		_is_recording = false;
+		if(_dropped_frames != 0)
+			core::error::report(e_kind::warning, "Frame recorder : %llu frames have been dropped during the recording", static_cast<unsigned long long>(_dropped_frames));
+		#ifdef DEBUG
+			core::error::report(e_kind::message, "Frame recorder : recorded %llu frames", static_cast<unsigned long long>(_recorded_frames.load()));
+		#endif
+	}
+
+	FrameRecorder::~FrameRecorder()
+	{
+		stop();
+	}
+}
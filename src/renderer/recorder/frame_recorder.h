@@ -0,0 +1,86 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   frame_recorder.h                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 02:36:52 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/19 02:36:52 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef __MLX_FRAME_RECORDER__
+#define __MLX_FRAME_RECORDER__
+
+#include <mlx_profile.h>
+#include <volk.h>
+#include <deque>
+#include <mutex>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <fstream>
+#include <filesystem>
+#include <condition_variable>
+
+#include <renderer/buffers/vk_buffer.h>
+#include <utils/non_copyable.h>
+
+namespace mlx
+{
+	class FrameRecorder : public NonCopyable
+	{
+		public:
+			enum class format { raw_rgba, y4m };
+
+		public:
+			FrameRecorder() = default;
+
+			bool start(const std::filesystem::path& filepath, std::uint32_t width, std::uint32_t height, VkFormat image_format, std::size_t slots_count, std::uint32_t fps);
+			void capture(class CmdBuffer& cmd, class Image& image) noexcept;
+			void onFrameCompleted(class CmdBuffer& cmd) noexcept;
+			void stop() noexcept;
+
+			inline bool isRecording() const noexcept { return _is_recording; }
+			inline std::uint64_t getRecordedFramesCount() const noexcept { return _recorded_frames; }
+			inline std::uint64_t getDroppedFramesCount() const noexcept { return _dropped_frames; }
+
+			~FrameRecorder();
+
+		private:
+			void writerLoop();
+			void writeFrame(const std::uint8_t* pixels);
+
+		private:
+			enum class slot_state { free, in_flight, ready };
+
+			struct Slot
+			{
+				Buffer buffer;
+				std::uint8_t* map = nullptr;
+				class CmdBuffer* cmd = nullptr;
+				slot_state state = slot_state::free;
+			};
+
+		private:
+			std::vector<Slot> _slots;
+			std::deque<std::size_t> _ready_slots;
+			std::vector<std::uint8_t> _conversion_buffer;
+			std::ofstream _file;
+			std::thread _writer;
+			std::mutex _mutex;
+			std::condition_variable _cv;
+			std::atomic<std::uint64_t> _recorded_frames = 0;
+			std::uint64_t _dropped_frames = 0;
+			std::size_t _next_slot = 0;
+			std::uint32_t _width = 0;
+			std::uint32_t _height = 0;
+			format _format = format::raw_rgba;
+			bool _swap_red_blue = false;
+			bool _should_stop = false;
+			bool _is_recording = false;
+	};
+}
+
+#endif
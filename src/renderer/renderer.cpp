@@ -6,22 +6,27 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/12/18 17:25:16 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/14 16:34:43 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 04:24:43 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include <renderer/renderer.h>
 #include <renderer/images/texture.h>
+#include <platform/window.h>
 #include <renderer/core/render_core.h>
 #include <core/profiler.h>
 
 namespace mlx
 {
-	void Renderer::init(Texture* render_target)
+	void Renderer::init(Texture* render_target, std::uint32_t frames_in_flight)
 	{
 		MLX_PROFILE_FUNCTION();
+		_frames_in_flight = frames_in_flight;
 		if(render_target == nullptr)
 		{
+			int width, height;
+			_window->getDrawableSize(width, height); // init always happens on the main thread
+			_drawable_size = { static_cast<std::uint32_t>(width), static_cast<std::uint32_t>(height) };
 			_surface.create(*this);
 			_swapchain.init(this);
 			_pass.init(_swapchain.getImagesFormat(), VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
@@ -31,14 +36,16 @@ namespace mlx
 		else
 		{
 			_render_target = render_target;
+			_render_target->markRenderedTo();
 			_render_target->transitionLayout(VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
 			_pass.init(_render_target->getFormat(), _render_target->getLayout());
 			_framebuffers.emplace_back().init(_pass, *static_cast<Image*>(_render_target));
 		}
-		_cmd.init();
+		_cmd.init(_frames_in_flight);
 
-		for(std::size_t i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
-			_semaphores[i].init();
+		_semaphores = std::vector<Semaphore>(_frames_in_flight);
+		for(Semaphore& semaphore : _semaphores)
+			semaphore.init();
 
 		_uniform_buffer.reset(new UBO);
 		#ifdef DEBUG
@@ -60,6 +67,9 @@ namespace mlx
 		_vert_set.writeDescriptor(0, _uniform_buffer.get());
 
 		_pipeline.init(*this);
+		_tilemap_pipeline.init(*this, GraphicPipeline::kind::tilemap);
+		_points_pipeline.init(*this, GraphicPipeline::kind::points);
+		_shapes_pipeline.init(*this, GraphicPipeline::kind::shapes);
 
 		_framebuffer_resized = false;
 	}
@@ -72,6 +82,14 @@ namespace mlx
 		if(_render_target == nullptr)
 		{
 			_cmd.getCmdBuffer(_current_frame_index).waitForExecution();
+			_recorder.onFrameCompleted(_cmd.getCmdBuffer(_current_frame_index));
+			collectRetiredResources(_current_frame_index);
+			if(_swapchain_out_of_date)
+			{
+				recreateRenderData();
+				if(_swapchain_out_of_date) // still minimized, nothing to render
+					return false;
+			}
 			VkResult result = vkAcquireNextImageKHR(device, _swapchain(), UINT64_MAX, _semaphores[_current_frame_index].getImageSemaphore(), VK_NULL_HANDLE, &_image_index);
 
 			if(result == VK_ERROR_OUT_OF_DATE_KHR)
@@ -91,8 +109,9 @@ namespace mlx
 
 		_cmd.getCmdBuffer(_current_frame_index).reset();
 		_cmd.getCmdBuffer(_current_frame_index).beginRecord();
-		auto& fb = _framebuffers[_image_index];
-		_pass.begin(getActiveCmdBuffer(), fb);
+		bool track_damage = isTrackingDamage();
+		auto& fb = (track_damage ? _damage_framebuffer : _framebuffers[_image_index]);
+		(track_damage ? _damage_pass : _pass).begin(getActiveCmdBuffer(), fb);
 
 		_pipeline.bindPipeline(_cmd.getCmdBuffer(_current_frame_index));
 
@@ -108,6 +127,18 @@ namespace mlx
 		VkRect2D scissor{};
 		scissor.offset = { 0, 0 };
 		scissor.extent = { fb.getWidth(), fb.getHeight()};
+		if(track_damage)
+		{
+			if(_damage_history_lost)
+			{
+				_frame_damage = scissor;
+				_damage_history_lost = false;
+			}
+			_frame_damage = rectIntersection(_frame_damage, scissor);
+			scissor = _frame_damage;
+			if(!rectIsEmpty(_frame_damage))
+				_damage_pass.clearArea(getActiveCmdBuffer(), _frame_damage);
+		}
 		vkCmdSetScissor(_cmd.getCmdBuffer(_current_frame_index).get(), 0, 1, &scissor);
 
 		return true;
@@ -116,12 +147,31 @@ namespace mlx
 	void Renderer::endFrame()
 	{
 		MLX_PROFILE_FUNCTION();
-		_pass.end(getActiveCmdBuffer());
+		if(isTrackingDamage())
+		{
+			_damage_pass.end(getActiveCmdBuffer());
+			presentDamageTarget();
+		}
+		else
+		{
+			_pass.end(getActiveCmdBuffer());
+			if(_render_target == nullptr)
+				_swapchain.getImage(_image_index).setLayout(VK_IMAGE_LAYOUT_PRESENT_SRC_KHR); // final layout of the pass
+		}
+		if(_recorder.isRecording())
+		{
+			if(_render_target == nullptr)
+				_recorder.capture(getActiveCmdBuffer(), _swapchain.getImage(_image_index));
+			else
+				_recorder.capture(getActiveCmdBuffer(), *_render_target);
+		}
 		_cmd.getCmdBuffer(_current_frame_index).endRecord();
 
 		if(_render_target == nullptr)
 		{
-			_cmd.getCmdBuffer(_current_frame_index).submit(&_semaphores[_current_frame_index]);
+			// the swapchain image is only touched by the final copy when tracking damage but its layout
+			// transition must still wait for the image to be acquired
+			_cmd.getCmdBuffer(_current_frame_index).submit(&_semaphores[_current_frame_index], isTrackingDamage() ? VK_PIPELINE_STAGE_ALL_COMMANDS_BIT : VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT);
 
 			VkSwapchainKHR swapchain = _swapchain();
 			VkSemaphore signalSemaphores[] = { _semaphores[_current_frame_index].getRenderImageSemaphore() };
@@ -134,6 +184,23 @@ namespace mlx
 			presentInfo.pSwapchains = &swapchain;
 			presentInfo.pImageIndices = &_image_index;
 
+			// tells the presentation engine which part of the image actually changed
+			VkRectLayerKHR damage_rect{};
+			VkPresentRegionKHR region{};
+			VkPresentRegionsKHR regions{};
+			if(isTrackingDamage() && Render_Core::get().getDevice().supportsIncrementalPresent())
+			{
+				damage_rect.offset = _frame_damage.offset;
+				damage_rect.extent = _frame_damage.extent;
+				damage_rect.layer = 0;
+				region.rectangleCount = 1;
+				region.pRectangles = &damage_rect;
+				regions.sType = VK_STRUCTURE_TYPE_PRESENT_REGIONS_KHR;
+				regions.swapchainCount = 1;
+				regions.pRegions = &region;
+				presentInfo.pNext = &regions;
+			}
+
 			VkResult result = vkQueuePresentKHR(Render_Core::get().getQueue().getPresent(), &presentInfo);
 
 			if(result == VK_ERROR_OUT_OF_DATE_KHR || result == VK_SUBOPTIMAL_KHR || _framebuffer_resized)
@@ -143,33 +210,208 @@ namespace mlx
 			}
 			else if(result != VK_SUCCESS)
 				core::error::report(e_kind::fatal_error, "Vulkan error : failed to present swap chain image");
-			_current_frame_index = (_current_frame_index + 1) % MAX_FRAMES_IN_FLIGHT;
+			_current_frame_index = (_current_frame_index + 1) % _frames_in_flight;
 		}
 		else
 		{
 			_cmd.getCmdBuffer(_current_frame_index).submitIdle(true);
+			_recorder.onFrameCompleted(_cmd.getCmdBuffer(_current_frame_index));
 			_current_frame_index = 0;
 		}
 	}
 
 	void Renderer::recreateRenderData()
 	{
-		_swapchain.recreate();
-		_pass.destroy();
-		_pass.init(_swapchain.getImagesFormat(), VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
-		for(auto& fb : _framebuffers)
-			fb.destroy();
+		MLX_PROFILE_FUNCTION();
+		VkFormat old_format = _swapchain.getImagesFormat();
+		_swapchain_out_of_date = !_swapchain.recreate();
+		if(_swapchain_out_of_date)
+			return;
+
+		if(_swapchain.getImagesFormat() != old_format)
+		{
+			// the render pass only depends on the format, so does the pipeline built against it
+			retire([pass = _pass, pipeline = _pipeline, tilemap_pipeline = _tilemap_pipeline, points_pipeline = _points_pipeline, shapes_pipeline = _shapes_pipeline]() mutable
+			{
+				pipeline.destroy();
+				tilemap_pipeline.destroy();
+				points_pipeline.destroy();
+				shapes_pipeline.destroy();
+				pass.destroy();
+			});
+			_pass = RenderPass{};
+			_pass.init(_swapchain.getImagesFormat(), VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+			_pipeline = GraphicPipeline{};
+			_pipeline.init(*this);
+			_tilemap_pipeline = GraphicPipeline{};
+			_tilemap_pipeline.init(*this, GraphicPipeline::kind::tilemap);
+			_points_pipeline = GraphicPipeline{};
+			_points_pipeline.init(*this, GraphicPipeline::kind::points);
+			_shapes_pipeline = GraphicPipeline{};
+			_shapes_pipeline.init(*this, GraphicPipeline::kind::shapes);
+		}
+
+		if(isTrackingDamage())
+		{
+			if(_swapchain.getImagesFormat() != old_format)
+			{
+				retire([pass = _damage_pass]() mutable { pass.destroy(); });
+				_damage_pass = RenderPass{};
+				_damage_pass.init(_swapchain.getImagesFormat(), VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_ATTACHMENT_LOAD_OP_LOAD);
+			}
+			createDamageTarget();
+		}
+
+		retire([framebuffers = std::move(_framebuffers)]() mutable
+		{
+			for(auto& fb : framebuffers)
+				fb.destroy();
+		});
 		_framebuffers.clear();
 		for(std::size_t i = 0; i < _swapchain.getImagesNumber(); i++)
 			_framebuffers.emplace_back().init(_pass, _swapchain.getImage(i));
 	}
 
+	void Renderer::setDamageTracking(bool enable)
+	{
+		MLX_PROFILE_FUNCTION();
+		if(_render_target != nullptr || enable == isTrackingDamage())
+			return;
+		if(enable)
+		{
+			if(!_swapchain.canBeCopiedInto())
+			{
+				core::error::report(e_kind::error, "Renderer : the surface does not allow its images to be copied into, cannot enable damage tracking");
+				return;
+			}
+			_damage_pass.init(_swapchain.getImagesFormat(), VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, VK_ATTACHMENT_LOAD_OP_LOAD);
+			createDamageTarget();
+			return;
+		}
+		retire([target = _damage_target, pass = _damage_pass, framebuffer = _damage_framebuffer]() mutable
+		{
+			framebuffer.destroy();
+			pass.destroy();
+			target->destroy();
+		});
+		_damage_target.reset();
+		_damage_pass = RenderPass{};
+		_damage_framebuffer = FrameBuffer{};
+		_stale_areas.clear();
+	}
+
+	void Renderer::createDamageTarget()
+	{
+		MLX_PROFILE_FUNCTION();
+		if(_damage_target)
+		{
+			// may still be read by frames in flight, the shared pointer keeps the image at the same address until then
+			retire([target = _damage_target, framebuffer = _damage_framebuffer]() mutable
+			{
+				framebuffer.destroy();
+				target->destroy();
+			});
+			_damage_framebuffer = FrameBuffer{};
+		}
+		VkExtent2D extent = _swapchain.getExtent();
+		_damage_target = std::make_shared<Image>();
+		_damage_target->create(extent.width, extent.height, _swapchain.getImagesFormat(), VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT, "__mlx_damage_target", true);
+		_damage_target->createImageView(VK_IMAGE_VIEW_TYPE_2D, VK_IMAGE_ASPECT_COLOR_BIT);
+		_damage_target->transitionLayout(VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+		_damage_framebuffer.init(_damage_pass, *_damage_target);
+
+		_stale_areas.assign(_swapchain.getImagesNumber(), VkRect2D{ { 0, 0 }, extent });
+		_damage_history_lost = true;
+	}
+
+	void Renderer::presentDamageTarget()
+	{
+		MLX_PROFILE_FUNCTION();
+		CmdBuffer& cmd = getActiveCmdBuffer();
+		Image& image = _swapchain.getImage(_image_index);
+
+		// the acquired image may be a few frames old, everything redrawn since it was last presented has to be copied
+		VkRect2D area = rectUnion(_stale_areas[_image_index], _frame_damage);
+		for(std::size_t i = 0; i < _stale_areas.size(); i++)
+			_stale_areas[i] = (i == _image_index ? VkRect2D{ { 0, 0 }, { 0, 0 } } : rectUnion(_stale_areas[i], _frame_damage));
+		if(rectIsEmpty(area))
+			return;
+
+		if(area.extent.width == image.getWidth() && area.extent.height == image.getHeight())
+			image.discardContent(); // fully overwritten, also covers images that have never been presented yet
+
+		_damage_target->transitionLayout(VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, &cmd);
+		image.transitionLayout(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, &cmd);
+		cmd.copyImageToImage(*_damage_target, image, area);
+		image.transitionLayout(VK_IMAGE_LAYOUT_PRESENT_SRC_KHR, &cmd);
+		_damage_target->transitionLayout(VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL, &cmd);
+	}
+
+	void Renderer::retire(std::function<void()> destroyer)
+	{
+		_retired_resources.push_back({ std::move(destroyer), (1u << _frames_in_flight) - 1 });
+	}
+
+	void Renderer::collectRetiredResources(std::uint32_t completed_frame) noexcept
+	{
+		MLX_PROFILE_FUNCTION();
+		for(auto it = _retired_resources.begin(); it != _retired_resources.end();)
+		{
+			it->pending_frames_mask &= ~(1u << completed_frame);
+			if(it->pending_frames_mask == 0)
+			{
+				it->destroyer();
+				it = _retired_resources.erase(it);
+			}
+			else
+				++it;
+		}
+	}
+
+	bool Renderer::startRecording(const std::filesystem::path& filepath, std::uint32_t fps)
+	{
+		MLX_PROFILE_FUNCTION();
+		if(_render_target == nullptr)
+		{
+			if(!_swapchain.canBeCopied())
+			{
+				core::error::report(e_kind::error, "Renderer : the surface does not allow its images to be copied, cannot record the window");
+				return false;
+			}
+			// one slot per frame in flight plus some more to let the writer thread lag a bit behind
+			return _recorder.start(filepath, _swapchain.getExtent().width, _swapchain.getExtent().height, _swapchain.getImagesFormat(), _frames_in_flight + 2, fps);
+		}
+		return _recorder.start(filepath, _render_target->getWidth(), _render_target->getHeight(), _render_target->getFormat(), 3, fps);
+	}
+
+	void Renderer::stopRecording()
+	{
+		MLX_PROFILE_FUNCTION();
+		if(!_recorder.isRecording())
+			return;
+		// frames that are still in flight are waited so they can be written before closing the file
+		for(std::uint32_t i = 0; i < _frames_in_flight; i++)
+		{
+			_cmd.getCmdBuffer(i).waitForExecution();
+			_recorder.onFrameCompleted(_cmd.getCmdBuffer(i));
+		}
+		_recorder.stop();
+	}
+
 	void Renderer::destroy()
 	{
 		MLX_PROFILE_FUNCTION();
 		vkDeviceWaitIdle(Render_Core::get().getDevice().get());
 
+		stopRecording();
+		for(RetiredResource& resource : _retired_resources)
+			resource.destroyer();
+		_retired_resources.clear();
+
 		_pipeline.destroy();
+		_tilemap_pipeline.destroy();
+		_points_pipeline.destroy();
+		_shapes_pipeline.destroy();
 		_uniform_buffer->destroy();
 		_vert_layout.destroy();
 		_frag_layout.destroy();
@@ -177,6 +419,13 @@ namespace mlx
 		_vert_set.destroy();
 		_cmd.destroy();
 		_pass.destroy();
+		if(_damage_target)
+		{
+			_damage_framebuffer.destroy();
+			_damage_pass.destroy();
+			_damage_target->destroy();
+			_damage_target.reset();
+		}
 		if(_render_target == nullptr)
 		{
 			_swapchain.destroy();
@@ -184,7 +433,8 @@ namespace mlx
 		}
 		for(auto& fb : _framebuffers)
 			fb.destroy();
-		for(int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
-			_semaphores[i].destroy();
+		for(Semaphore& semaphore : _semaphores)
+			semaphore.destroy();
+		_semaphores.clear();
 	}
 }
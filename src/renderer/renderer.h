@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/12/18 17:14:45 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/14 16:34:20 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 04:24:43 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -15,6 +15,7 @@
 
 #include <vector>
 #include <memory>
+#include <functional>
 
 #include <renderer/buffers/vk_ubo.h>
 #include <renderer/core/vk_surface.h>
@@ -28,6 +29,8 @@
 #include <renderer/descriptors/vk_descriptor_set.h>
 #include <renderer/descriptors/vk_descriptor_pool.h>
 #include <renderer/descriptors/vk_descriptor_set_layout.h>
+#include <renderer/recorder/frame_recorder.h>
+#include <utils/rect.h>
 
 #include <core/errors.h>
 #include <mlx_profile.h>
@@ -82,23 +85,40 @@ namespace mlx
 		public:
 			Renderer() = default;
 
-			void init(class Texture* render_target);
+			void init(class Texture* render_target, std::uint32_t frames_in_flight = DEFAULT_FRAMES_IN_FLIGHT);
 
 			bool beginFrame();
 			void endFrame();
 
+			bool startRecording(const std::filesystem::path& filepath, std::uint32_t fps);
+			void stopRecording();
+
+			void retire(std::function<void()> destroyer);
+
+			void setDamageTracking(bool enable);
+			inline bool isTrackingDamage() const noexcept { return _damage_target != nullptr; }
+			inline void setFrameDamage(VkRect2D damage) noexcept { _frame_damage = damage; }
+			inline VkRect2D getFrameDamage() const noexcept { return _frame_damage; } // may be wider than requested if the previous content has been lost
+			inline bool hasLostPreviousFrame() const noexcept { return _damage_history_lost; }
+
 			void destroy();
 
 			inline class MLX_Window* getWindow() { return _window; }
 			inline void setWindow(class MLX_Window* window) { _window = window; }
+			inline void setDrawableSize(VkExtent2D size) noexcept { _drawable_size = size; } // queried by the main thread, SDL does not allow it anywhere else
+			inline VkExtent2D getDrawableSize() const noexcept { return _drawable_size; }
 
 			inline Surface& getSurface() noexcept { return _surface; }
 			inline CmdPool& getCmdPool() noexcept { return _cmd.getCmdPool(); }
 			inline UBO* getUniformBuffer() noexcept { return _uniform_buffer.get(); }
 			inline SwapChain& getSwapChain() noexcept { return _swapchain; }
+			inline FrameRecorder& getRecorder() noexcept { return _recorder; }
 			inline Semaphore& getSemaphore(int i) noexcept { return _semaphores[i]; }
 			inline RenderPass& getRenderPass() noexcept { return _pass; }
 			inline GraphicPipeline& getPipeline() noexcept { return _pipeline; }
+			inline GraphicPipeline& getTilemapPipeline() noexcept { return _tilemap_pipeline; }
+			inline GraphicPipeline& getPointsPipeline() noexcept { return _points_pipeline; }
+			inline GraphicPipeline& getShapesPipeline() noexcept { return _shapes_pipeline; }
 			inline CmdBuffer& getCmdBuffer(int i) noexcept { return _cmd.getCmdBuffer(i); }
 			inline CmdBuffer& getActiveCmdBuffer() noexcept { return _cmd.getCmdBuffer(_current_frame_index); }
 			inline FrameBuffer& getFrameBuffer(int i) noexcept { return _framebuffers[i]; }
@@ -108,22 +128,39 @@ namespace mlx
 			inline DescriptorSetLayout& getFragDescriptorSetLayout() noexcept { return _frag_layout; }
 			inline std::uint32_t getActiveImageIndex() noexcept { return _current_frame_index; }
 			inline std::uint32_t getImageIndex() noexcept { return _image_index; }
+			inline std::uint32_t getFramesInFlight() const noexcept { return _frames_in_flight; }
 
 			constexpr inline void requireFrameBufferResize() noexcept { _framebuffer_resized = true; }
+			inline void setPresentMode(VkPresentModeKHR mode) noexcept { _swapchain.setRequestedPresentMode(mode); requireFrameBufferResize(); }
 
 			~Renderer() = default;
 
 		private:
 			void recreateRenderData();
+			void collectRetiredResources(std::uint32_t completed_frame) noexcept;
+			void createDamageTarget();
+			void presentDamageTarget();
+
+		private:
+			struct RetiredResource
+			{
+				std::function<void()> destroyer;
+				std::uint32_t pending_frames_mask; // frames that were in flight when the resource has been retired
+			};
 
 		private:
 			GraphicPipeline _pipeline;
+			GraphicPipeline _tilemap_pipeline;
+			GraphicPipeline _points_pipeline;
+			GraphicPipeline _shapes_pipeline;
 			CmdManager _cmd;
+			FrameRecorder _recorder;
 			RenderPass _pass;
 			Surface _surface;
 			SwapChain _swapchain;
-			std::array<Semaphore, MAX_FRAMES_IN_FLIGHT> _semaphores;
+			std::vector<Semaphore> _semaphores;
 			std::vector<FrameBuffer> _framebuffers;
+			std::vector<RetiredResource> _retired_resources;
 
 			DescriptorSetLayout _vert_layout;
 			DescriptorSetLayout _frag_layout;
@@ -133,12 +170,23 @@ namespace mlx
 
 			std::unique_ptr<UBO> _uniform_buffer;
 
+			// damage tracking, frames are rendered in a persistent image that is partially redrawn and copied to the swapchain
+			std::shared_ptr<Image> _damage_target;
+			RenderPass _damage_pass;
+			FrameBuffer _damage_framebuffer;
+			std::vector<VkRect2D> _stale_areas; // per swapchain image, what has been redrawn since it was last presented
+			VkRect2D _frame_damage = { { 0, 0 }, { 0, 0 } };
+
 			class MLX_Window* _window = nullptr;
 			class Texture* _render_target = nullptr;
 
 			std::uint32_t _current_frame_index = 0;
 			std::uint32_t _image_index = 0;
+			std::uint32_t _frames_in_flight = DEFAULT_FRAMES_IN_FLIGHT;
+			VkExtent2D _drawable_size = { 0, 0 };
 			bool _framebuffer_resized = false;
+			bool _swapchain_out_of_date = false;
+			bool _damage_history_lost = false;
 	};
 }
 
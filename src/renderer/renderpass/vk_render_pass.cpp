@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/10/06 18:21:36 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/14 17:06:01 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 02:53:36 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -20,16 +20,16 @@ namespace mlx
 {
 	static const VkClearValue clearColor = {{{ 0.f, 0.f, 0.f, 1.0f }}}; // wtf, this mess to satisfy a warning
 
-	void RenderPass::init(VkFormat attachement_format, VkImageLayout layout)
+	void RenderPass::init(VkFormat attachement_format, VkImageLayout layout, VkAttachmentLoadOp load_op)
 	{
 		VkAttachmentDescription colorAttachment{};
 		colorAttachment.format = attachement_format;
 		colorAttachment.samples = VK_SAMPLE_COUNT_1_BIT;
-		colorAttachment.loadOp = VK_ATTACHMENT_LOAD_OP_CLEAR;
+		colorAttachment.loadOp = load_op;
 		colorAttachment.storeOp = VK_ATTACHMENT_STORE_OP_STORE;
 		colorAttachment.stencilLoadOp = VK_ATTACHMENT_LOAD_OP_DONT_CARE;
 		colorAttachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
-		colorAttachment.initialLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		colorAttachment.initialLayout = (load_op == VK_ATTACHMENT_LOAD_OP_LOAD ? layout : VK_IMAGE_LAYOUT_UNDEFINED); // previous content must be kept
 		colorAttachment.finalLayout = layout;
 
 		VkAttachmentReference colorAttachmentRef{};
@@ -99,6 +99,25 @@ namespace mlx
 		_is_running = true;
 	}
 
+	void RenderPass::clearArea(class CmdBuffer& cmd, VkRect2D area)
+	{
+		MLX_PROFILE_FUNCTION();
+		if(!_is_running)
+			return;
+
+		VkClearAttachment attachment{};
+		attachment.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		attachment.colorAttachment = 0;
+		attachment.clearValue = clearColor;
+
+		VkClearRect rect{};
+		rect.rect = area;
+		rect.baseArrayLayer = 0;
+		rect.layerCount = 1;
+
+		vkCmdClearAttachments(cmd.get(), 1, &attachment, 1, &rect);
+	}
+
 	void RenderPass::end(class CmdBuffer& cmd)
 	{
 		MLX_PROFILE_FUNCTION();
@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/10/06 18:22:00 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/14 17:05:40 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 02:53:36 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -21,11 +21,12 @@ namespace mlx
 	class RenderPass
 	{
 		public:
-			void init(VkFormat attachement_format, VkImageLayout layout);
+			void init(VkFormat attachement_format, VkImageLayout layout, VkAttachmentLoadOp load_op = VK_ATTACHMENT_LOAD_OP_CLEAR);
 			void destroy() noexcept;
 
 			void begin(class CmdBuffer& cmd, class FrameBuffer& fb);
 			void end(class CmdBuffer& cmd);
+			void clearArea(class CmdBuffer& cmd, VkRect2D area); // clears a part of the attachment with the render pass clear color
 			
 			inline VkRenderPass& operator()() noexcept { return _render_pass; }
 			inline VkRenderPass& get() noexcept { return _render_pass; }
@@ -0,0 +1,282 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   shape_batch.cpp                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 04:00:52 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/19 04:37:59 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <renderer/shape_batch.h>
+#include <renderer/pipeline/pipeline.h>
+#include <utils/combine_hash.h>
+#include <utils/rect.h>
+#include <glm/gtc/constants.hpp>
+#include <algorithm>
+#include <numeric>
+#include <string_view>
+#include <cmath>
+#include <core/profiler.h>
+
+namespace mlx
+{
+	void ShapeBatch::add(const Vertex* vertices, std::size_t count)
+	{
+		MLX_PROFILE_FUNCTION();
+		if(count == 0)
+			return;
+		glm::vec2 min = vertices[0].pos;
+		glm::vec2 max = vertices[0].pos;
+		for(std::size_t i = 1; i < count; i++)
+		{
+			min = glm::min(min, vertices[i].pos);
+			max = glm::max(max, vertices[i].pos);
+		}
+		glm::ivec2 top_left = glm::floor(min);
+		glm::ivec2 bottom_right = glm::ceil(max);
+		_bounds = rectUnion(_bounds, { { top_left.x, top_left.y }, { static_cast<std::uint32_t>(bottom_right.x - top_left.x), static_cast<std::uint32_t>(bottom_right.y - top_left.y) } });
+		_vertices.insert(_vertices.end(), vertices, vertices + count);
+		_version++;
+	}
+
+	std::size_t ShapeBatch::getSignature() const noexcept
+	{
+		// hashes the content as shapes are usually cleared and put again each frame, most of the time identical
+		if(_signature_version == _version)
+			return _signature;
+		std::size_t hash = std::hash<std::string_view>{}(std::string_view(reinterpret_cast<const char*>(_vertices.data()), sizeof(Vertex) * _vertices.size()));
+		hashCombine(hash, _bounds.offset.x, _bounds.offset.y, _bounds.extent.width, _bounds.extent.height);
+		_signature = hash;
+		_signature_version = _version;
+		return hash;
+	}
+
+	void ShapeBatch::render(std::array<VkDescriptorSet, 2>& sets, Renderer& renderer)
+	{
+		MLX_PROFILE_FUNCTION();
+		if(_vertices.empty())
+			return;
+		if(_vbos.empty())
+		{
+			_vbos.resize(renderer.getFramesInFlight());
+			_vbos_versions.assign(_vbos.size(), _version - 1);
+		}
+		// the buffer of the frame being recorded is not read by the ones still in flight
+		std::uint32_t frame = renderer.getActiveImageIndex();
+		VBO& vbo = _vbos[frame];
+		std::uint32_t size = static_cast<std::uint32_t>(sizeof(Vertex) * _vertices.size());
+		if(_vbos_versions[frame] != _version)
+		{
+			if(vbo.getSize() < size)
+			{
+				VkDeviceSize capacity = std::max<VkDeviceSize>(size, vbo.getSize() * 2);
+				if(vbo.getSize() != 0)
+					vbo.destroy();
+				vbo.create(static_cast<std::uint32_t>(capacity), nullptr, "__mlx_shape_batch");
+			}
+			vbo.setData(size, _vertices.data());
+			_vbos_versions[frame] = _version;
+		}
+
+		ModelPushConstant model(glm::vec2(0.f, 0.f));
+		CmdBuffer& cmd = renderer.getActiveCmdBuffer();
+		GraphicPipeline& pipeline = renderer.getShapesPipeline();
+		pipeline.bindPipeline(cmd);
+		vbo.bind(renderer);
+		vkCmdPushConstants(cmd.get(), pipeline.getPipelineLayout(), VK_SHADER_STAGE_VERTEX_BIT, 0, sizeof(model), &model);
+		vkCmdBindDescriptorSets(cmd.get(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline.getPipelineLayout(), 0, 1, &sets[0], 0, nullptr);
+		vkCmdDraw(cmd.get(), static_cast<std::uint32_t>(_vertices.size()), 1, 0, 0);
+		renderer.getPipeline().bindPipeline(cmd); // the following resources expect the textured pipeline
+	}
+
+	void ShapeBatch::clear() noexcept
+	{
+		_vertices.clear();
+		_bounds = { { 0, 0 }, { 0, 0 } };
+		_version++;
+	}
+
+	void ShapeBatch::destroy() noexcept
+	{
+		MLX_PROFILE_FUNCTION();
+		for(VBO& vbo : _vbos)
+		{
+			if(vbo.getSize() != 0)
+				vbo.destroy();
+		}
+		_vbos.clear();
+		_vbos_versions.clear();
+		clear();
+	}
+
+	namespace
+	{
+		inline glm::vec4 toColor(std::uint32_t color) noexcept
+		{
+			return glm::vec4(color & 0xFF, (color >> 8) & 0xFF, (color >> 16) & 0xFF, (color >> 24) & 0xFF) / 255.f;
+		}
+
+		inline void pushTriangle(std::vector<Vertex>& out, glm::vec2 a, glm::vec2 b, glm::vec2 c, glm::vec4 color)
+		{
+			out.emplace_back(a, color, glm::vec2(0.f, 0.f));
+			out.emplace_back(b, color, glm::vec2(0.f, 0.f));
+			out.emplace_back(c, color, glm::vec2(0.f, 0.f));
+		}
+
+		inline void pushQuad(std::vector<Vertex>& out, glm::vec2 a, glm::vec2 b, glm::vec2 c, glm::vec2 d, glm::vec4 color)
+		{
+			pushTriangle(out, a, b, c, color);
+			pushTriangle(out, a, c, d, color);
+		}
+
+		inline double cross(glm::dvec2 a, glm::dvec2 b, glm::dvec2 c) noexcept // in double as nearly flat corners are common
+		{
+			return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+		}
+
+		// enough segments to keep the polygon within a quarter of pixel of the circle
+		std::size_t circleSegments(float radius) noexcept
+		{
+			if(radius <= 0.25f)
+				return 8;
+			float segments = std::ceil(glm::pi<float>() / std::acos(1.f - 0.25f / radius));
+			return static_cast<std::size_t>(std::clamp(segments, 8.f, 1024.f));
+		}
+	}
+
+	void tessellateLine(std::vector<Vertex>& out, glm::vec2 from, glm::vec2 to, float thickness, std::uint32_t color)
+	{
+		// the line runs through the pixel centers and its square caps cover the end pixels
+		glm::vec2 dir = to - from;
+		float length = glm::length(dir);
+		dir = (length > 0.f ? dir / length : glm::vec2(1.f, 0.f));
+		float half = std::max(thickness, 1.f) * 0.5f;
+		glm::vec2 normal = glm::vec2(-dir.y, dir.x) * half;
+		glm::vec2 start = from + 0.5f - dir * half;
+		glm::vec2 end = to + 0.5f + dir * half;
+		pushQuad(out, start + normal, end + normal, end - normal, start - normal, toColor(color));
+	}
+
+	void tessellateFilledRect(std::vector<Vertex>& out, glm::vec2 pos, glm::vec2 size, std::uint32_t color)
+	{
+		if(size.x <= 0.f || size.y <= 0.f)
+			return;
+		pushQuad(out, pos, { pos.x + size.x, pos.y }, pos + size, { pos.x, pos.y + size.y }, toColor(color));
+	}
+
+	void tessellateRect(std::vector<Vertex>& out, glm::vec2 pos, glm::vec2 size, float thickness, std::uint32_t color)
+	{
+		if(size.x <= 0.f || size.y <= 0.f)
+			return;
+		thickness = std::max(thickness, 1.f);
+		if(thickness * 2.f >= size.x || thickness * 2.f >= size.y) // the bands would cover the whole rectangle
+		{
+			tessellateFilledRect(out, pos, size, color);
+			return;
+		}
+		tessellateFilledRect(out, pos, { size.x, thickness }, color);
+		tessellateFilledRect(out, { pos.x, pos.y + size.y - thickness }, { size.x, thickness }, color);
+		tessellateFilledRect(out, { pos.x, pos.y + thickness }, { thickness, size.y - thickness * 2.f }, color);
+		tessellateFilledRect(out, { pos.x + size.x - thickness, pos.y + thickness }, { thickness, size.y - thickness * 2.f }, color);
+	}
+
+	void tessellateCircle(std::vector<Vertex>& out, glm::vec2 center, float radius, float thickness, std::uint32_t color)
+	{
+		if(radius < 0.f)
+			return;
+		center += 0.5f;
+		glm::vec4 rgba = toColor(color);
+		bool filled = (thickness <= 0.f);
+		float outer = radius + (filled ? 0.5f : thickness * 0.5f);
+		float inner = (filled ? 0.f : std::max(radius - thickness * 0.5f, 0.f));
+		std::size_t segments = circleSegments(outer);
+		glm::vec2 prev(1.f, 0.f);
+		for(std::size_t i = 1; i <= segments; i++)
+		{
+			float angle = glm::two_pi<float>() * static_cast<float>(i) / static_cast<float>(segments);
+			glm::vec2 next(std::cos(angle), std::sin(angle));
+			if(inner == 0.f)
+				pushTriangle(out, center, center + prev * outer, center + next * outer, rgba);
+			else
+				pushQuad(out, center + prev * inner, center + prev * outer, center + next * outer, center + next * inner, rgba);
+			prev = next;
+		}
+	}
+
+	void tessellatePolygon(std::vector<Vertex>& out, const std::vector<glm::vec2>& points, std::uint32_t color)
+	{
+		MLX_PROFILE_FUNCTION();
+		if(points.size() < 3)
+			return;
+		float area = 0.f;
+		for(std::size_t i = 0, j = points.size() - 1; i < points.size(); j = i++)
+			area += points[j].x * points[i].y - points[i].x * points[j].y;
+		if(area == 0.f)
+			return;
+
+		// ear clipping, the indices are kept in positive winding so ears are the convex corners
+		std::vector<std::size_t> indices(points.size());
+		std::iota(indices.begin(), indices.end(), 0);
+		if(area < 0.f)
+			std::reverse(indices.begin(), indices.end());
+		glm::vec4 rgba = toColor(color);
+		glm::vec2 offset(0.5f, 0.5f);
+
+		// only reflex corners may lie inside an ear, clipping an ear never turns a convex corner into a reflex one
+		auto corner = [&](std::size_t at) { std::size_t count = indices.size(); return cross(points[indices[(at + count - 1) % count]], points[indices[at]], points[indices[(at + 1) % count]]); };
+		std::vector<std::size_t> reflex;
+		for(std::size_t j = 0; j < indices.size(); j++)
+		{
+			if(corner(j) < 0.0)
+				reflex.push_back(indices[j]);
+		}
+		if(reflex.empty()) // convex polygons are fanned without looking for ears
+		{
+			for(std::size_t j = 1; j + 1 < indices.size(); j++)
+				pushTriangle(out, points[indices[0]] + offset, points[indices[j]] + offset, points[indices[j + 1]] + offset, rgba);
+			return;
+		}
+
+		std::size_t i = 0;
+		std::size_t attempts = 0;
+		while(indices.size() > 3)
+		{
+			std::size_t count = indices.size();
+			i %= count;
+			const glm::vec2& a = points[indices[(i + count - 1) % count]];
+			const glm::vec2& b = points[indices[i]];
+			const glm::vec2& c = points[indices[(i + 1) % count]];
+			double b_corner = cross(a, b, c);
+			bool is_ear = (b_corner > 0.0);
+			for(std::size_t j = 0; is_ear && j < reflex.size(); j++)
+			{
+				const glm::vec2& p = points[reflex[j]];
+				if(p == a || p == b || p == c)
+					continue;
+				is_ear = !(cross(a, b, p) >= 0.0 && cross(b, c, p) >= 0.0 && cross(c, a, p) >= 0.0);
+			}
+			// a self intersecting polygon may have no ear left, a corner is clipped anyway to always terminate
+			if(!is_ear && b_corner != 0.0 && attempts < count)
+			{
+				i++;
+				attempts++;
+				continue;
+			}
+			if(b_corner != 0.0)
+				pushTriangle(out, a + offset, b + offset, c + offset, rgba);
+			reflex.erase(std::remove(reflex.begin(), reflex.end(), indices[i]), reflex.end());
+			indices.erase(indices.begin() + i);
+			attempts = 0;
+			// the neighbours of the clipped corner may have become convex
+			for(std::size_t at : { (i + indices.size() - 1) % indices.size(), i % indices.size() })
+			{
+				if(corner(at) >= 0.0)
+					reflex.erase(std::remove(reflex.begin(), reflex.end(), indices[at]), reflex.end());
+			}
+		}
+		pushTriangle(out, points[indices[0]] + offset, points[indices[1]] + offset, points[indices[2]] + offset, rgba);
+	}
+}
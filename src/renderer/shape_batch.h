@@ -0,0 +1,62 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   shape_batch.h                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 04:00:52 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/19 04:37:59 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef __MLX_SHAPE_BATCH__
+#define __MLX_SHAPE_BATCH__
+
+#include <mlx_profile.h>
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <renderer/renderer.h>
+#include <renderer/core/drawable_resource.h>
+#include <renderer/buffers/vk_vbo.h>
+
+namespace mlx
+{
+	// triangles of the shapes put one after the other, drawn in a single call by the untextured pipeline
+	class ShapeBatch : public DrawableResource
+	{
+		public:
+			ShapeBatch() = default;
+
+			void add(const Vertex* vertices, std::size_t count);
+			void render(std::array<VkDescriptorSet, 2>& sets, class Renderer& renderer) override;
+			void clear() noexcept; // keeps the buffers, frames in flight may still read them
+			void destroy() noexcept;
+
+			std::size_t getSignature() const noexcept override;
+			inline VkRect2D getBounds() const noexcept override { return _bounds; }
+			inline bool isEmpty() const noexcept { return _vertices.empty(); }
+
+			~ShapeBatch() = default;
+
+		private:
+			std::vector<Vertex> _vertices;
+			std::vector<VBO> _vbos; // one per frame in flight, grown when the batch outgrows them
+			std::vector<std::uint64_t> _vbos_versions;
+			VkRect2D _bounds = { { 0, 0 }, { 0, 0 } };
+			std::uint64_t _version = 0; // of the vertices, for the buffers uploads
+			mutable std::size_t _signature = 0;
+			mutable std::uint64_t _signature_version = UINT64_MAX;
+	};
+
+	// the shapes are given in window pixels, colors as packed RGBA bytes like pixel puts
+	void tessellateLine(std::vector<Vertex>& out, glm::vec2 from, glm::vec2 to, float thickness, std::uint32_t color);
+	void tessellateRect(std::vector<Vertex>& out, glm::vec2 pos, glm::vec2 size, float thickness, std::uint32_t color); // the outline is drawn inside the rectangle
+	void tessellateFilledRect(std::vector<Vertex>& out, glm::vec2 pos, glm::vec2 size, std::uint32_t color);
+	void tessellateCircle(std::vector<Vertex>& out, glm::vec2 center, float radius, float thickness, std::uint32_t color); // a thickness of 0 fills it
+	void tessellatePolygon(std::vector<Vertex>& out, const std::vector<glm::vec2>& points, std::uint32_t color); // simple polygons of any winding
+}
+
+#endif
@@ -6,27 +6,30 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/10/06 18:22:28 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/14 17:08:19 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 04:24:43 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include <renderer/core/render_core.h>
 #include <renderer/renderer.h>
-#include <platform/window.h>
-#include <SDL2/SDL_vulkan.h>
 #include <algorithm>
 
 namespace mlx
 {
 	void SwapChain::init(Renderer* renderer)
 	{
-		VkDevice device = Render_Core::get().getDevice().get();
-
 		_renderer = renderer;
 		_swapchain_support = querySwapChainSupport(Render_Core::get().getDevice().getPhysicalDevice());
+		create(VK_NULL_HANDLE);
+	}
+
+	void SwapChain::create(VkSwapchainKHR old_swapchain)
+	{
+		VkDevice device = Render_Core::get().getDevice().get();
+		Renderer* renderer = _renderer;
 
 		VkSurfaceFormatKHR surfaceFormat = renderer->getSurface().chooseSwapSurfaceFormat(_swapchain_support.formats);
-		VkPresentModeKHR presentMode = chooseSwapPresentMode(_swapchain_support.present_modes);
+		_present_mode = chooseSwapPresentMode(_swapchain_support.present_modes);
 		_extent = chooseSwapExtent(_swapchain_support.capabilities);
 
 		std::uint32_t imageCount = _swapchain_support.capabilities.minImageCount + 1;
@@ -45,11 +48,15 @@ namespace mlx
 		createInfo.imageExtent = _extent;
 		createInfo.imageArrayLayers = 1;
 		createInfo.imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+		if(_swapchain_support.capabilities.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_SRC_BIT) // needed to read back presented frames
+			createInfo.imageUsage |= VK_IMAGE_USAGE_TRANSFER_SRC_BIT;
+		if(_swapchain_support.capabilities.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_DST_BIT) // needed to present offscreen rendered frames
+			createInfo.imageUsage |= VK_IMAGE_USAGE_TRANSFER_DST_BIT;
 		createInfo.preTransform = _swapchain_support.capabilities.currentTransform;
 		createInfo.compositeAlpha = VK_COMPOSITE_ALPHA_OPAQUE_BIT_KHR;
-		createInfo.presentMode = presentMode;
+		createInfo.presentMode = _present_mode;
 		createInfo.clipped = VK_TRUE;
-		createInfo.oldSwapchain = VK_NULL_HANDLE;
+		createInfo.oldSwapchain = old_swapchain; // lets the presentation engine reuse resources and keep presenting while we switch
 		if(indices.graphics_family != indices.present_family)
 		{
 			createInfo.imageSharingMode = VK_SHARING_MODE_CONCURRENT;
@@ -71,8 +78,9 @@ namespace mlx
 
 		for(std::size_t i = 0; i < imageCount; i++)
 		{
-			_images[i].create(tmp[i], surfaceFormat.format, _extent.width, _extent.height);
-			_images[i].transitionLayout(VK_IMAGE_LAYOUT_PRESENT_SRC_KHR);
+			// no explicit transition as it would stall the queue, the render pass starts from an undefined
+			// layout and always leaves the images in the present layout
+			_images[i].create(tmp[i], surfaceFormat.format, _extent.width, _extent.height); // undefined until the first pass writes them
 			_images[i].createImageView(VK_IMAGE_VIEW_TYPE_2D, VK_IMAGE_ASPECT_COLOR_BIT);
 		}
 
@@ -111,10 +119,25 @@ namespace mlx
 		return details;
 	}
 
-	VkPresentModeKHR SwapChain::chooseSwapPresentMode([[maybe_unused]] const std::vector<VkPresentModeKHR>& availablePresentModes)
+	VkPresentModeKHR SwapChain::chooseSwapPresentMode(const std::vector<VkPresentModeKHR>& availablePresentModes)
 	{
-		// in the future, you may choose to activate vsync or not
-		return VK_PRESENT_MODE_IMMEDIATE_KHR;
+		auto is_available = [&](VkPresentModeKHR mode)
+		{
+			return std::find(availablePresentModes.begin(), availablePresentModes.end(), mode) != availablePresentModes.end();
+		};
+
+		if(is_available(_requested_present_mode))
+			return _requested_present_mode;
+
+		// non vsynced modes fallback on each other before falling back on FIFO that is always supported
+		VkPresentModeKHR fallback = VK_PRESENT_MODE_FIFO_KHR;
+		if(_requested_present_mode == VK_PRESENT_MODE_MAILBOX_KHR && is_available(VK_PRESENT_MODE_IMMEDIATE_KHR))
+			fallback = VK_PRESENT_MODE_IMMEDIATE_KHR;
+		else if(_requested_present_mode == VK_PRESENT_MODE_IMMEDIATE_KHR && is_available(VK_PRESENT_MODE_MAILBOX_KHR))
+			fallback = VK_PRESENT_MODE_MAILBOX_KHR;
+		if(_present_mode != fallback)
+			core::error::report(e_kind::warning, "Vulkan : requested present mode is not supported by the surface, falling back on another one");
+		return fallback;
 	}
 
 	VkExtent2D SwapChain::chooseSwapExtent(const VkSurfaceCapabilitiesKHR& capabilities)
@@ -122,10 +145,7 @@ namespace mlx
 		if(capabilities.currentExtent.width != std::numeric_limits<std::uint32_t>::max())
 			return capabilities.currentExtent;
 
-		int width, height;
-		SDL_Vulkan_GetDrawableSize(_renderer->getWindow()->getNativeWindow(), &width, &height);
-
-		VkExtent2D actualExtent = { static_cast<std::uint32_t>(width), static_cast<std::uint32_t>(height) };
+		VkExtent2D actualExtent = _renderer->getDrawableSize();
 
 		actualExtent.width = std::clamp(actualExtent.width, capabilities.minImageExtent.width, capabilities.maxImageExtent.width);
 		actualExtent.height = std::clamp(actualExtent.height, capabilities.minImageExtent.height, capabilities.maxImageExtent.height);
@@ -133,10 +153,27 @@ namespace mlx
 		return actualExtent;
 	}
 
-	void SwapChain::recreate()
+	bool SwapChain::recreate()
 	{
-		destroy();
-		init(_renderer);
+		_swapchain_support = querySwapChainSupport(Render_Core::get().getDevice().getPhysicalDevice());
+		VkExtent2D extent = chooseSwapExtent(_swapchain_support.capabilities);
+		if(extent.width == 0 || extent.height == 0)
+			return false;
+
+		VkSwapchainKHR old_swapchain = _swapchain;
+		// the old images may still be referenced by frames in flight, they are kept alive until those are done
+		auto old_images = std::make_shared<std::vector<Image>>(std::move(_images));
+		_images.clear();
+
+		create(old_swapchain);
+
+		_renderer->retire([old_swapchain, old_images]()
+		{
+			for(Image& img : *old_images)
+				img.destroyImageView();
+			vkDestroySwapchainKHR(Render_Core::get().getDevice().get(), old_swapchain, nullptr);
+		});
+		return true;
 	}
 
 	void SwapChain::destroy() noexcept
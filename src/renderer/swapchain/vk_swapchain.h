@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2022/10/06 18:23:27 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/14 17:06:41 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 02:53:36 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -38,12 +38,15 @@ namespace mlx
 			SwapChain() = default;
 
 			void init(class Renderer* renderer);
-			void recreate();
+			bool recreate(); // returns false if the surface cannot hold a swapchain for now (minimized window)
 			void destroy() noexcept;
 
 			SwapChainSupportDetails querySwapChainSupport(VkPhysicalDevice device);
 			VkExtent2D chooseSwapExtent(const VkSurfaceCapabilitiesKHR& capabilities);
-			VkPresentModeKHR chooseSwapPresentMode([[maybe_unused]] const std::vector<VkPresentModeKHR> &availablePresentModes);
+			VkPresentModeKHR chooseSwapPresentMode(const std::vector<VkPresentModeKHR>& availablePresentModes);
+
+			inline void setRequestedPresentMode(VkPresentModeKHR mode) noexcept { _requested_present_mode = mode; }
+			inline VkPresentModeKHR getPresentMode() const noexcept { return _present_mode; }
 
 			inline VkSwapchainKHR get() noexcept { return _swapchain; }
 			inline VkSwapchainKHR operator()() noexcept { return _swapchain; }
@@ -52,15 +55,22 @@ namespace mlx
 			inline SwapChainSupportDetails getSupport() noexcept { return _swapchain_support; }
 			inline VkExtent2D getExtent() noexcept { return _extent; }
 			inline VkFormat getImagesFormat() const noexcept { return _swapchain_image_format; }
+			inline bool canBeCopied() const noexcept { return _swapchain_support.capabilities.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_SRC_BIT; }
+			inline bool canBeCopiedInto() const noexcept { return _swapchain_support.capabilities.supportedUsageFlags & VK_IMAGE_USAGE_TRANSFER_DST_BIT; }
 
 			~SwapChain() = default;
 
+		private:
+			void create(VkSwapchainKHR old_swapchain);
+
 		private:
 			SwapChainSupportDetails _swapchain_support;
-			VkSwapchainKHR _swapchain;
+			VkSwapchainKHR _swapchain = VK_NULL_HANDLE;
 			std::vector<Image> _images;
 			VkFormat _swapchain_image_format;
 			VkExtent2D _extent;
+			VkPresentModeKHR _requested_present_mode = VK_PRESENT_MODE_IMMEDIATE_KHR;
+			VkPresentModeKHR _present_mode = VK_PRESENT_MODE_IMMEDIATE_KHR;
 			class Renderer* _renderer = nullptr;
 	};
 }
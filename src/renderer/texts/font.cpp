@@ -6,17 +6,21 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/12/11 22:06:09 by kbz_8             #+#    #+#             */
-/*   Updated: 2024/01/18 13:16:18 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 03:11:53 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include <renderer/texts/font.h>
 #include <renderer/renderer.h>
 #include <core/profiler.h>
+#include <utils/asset_pack_format.h>
 #include <fstream>
+#include <cstring>
 
 constexpr const int RANGE = 1024;
 
+static_assert(RANGE == mlx::pack::FONT_ATLAS_SIZE && sizeof(stbtt_packedchar) == sizeof(mlx::pack::Glyph), "asset packs fonts must be baked like the runtime ones");
+
 namespace mlx
 {
 	Font::Font(Renderer& renderer, const std::filesystem::path& path, float scale) : _name(path.string()), _renderer(renderer), _scale(scale)
@@ -29,7 +33,19 @@ namespace mlx
 		_build_data = ttf_data;
 	}
 
+	Font::Font(class Renderer& renderer, const std::string& name, float scale, const stbtt_packedchar* cdata, const std::uint8_t* bitmap) : _name(name), _renderer(renderer), _scale(scale)
+	{
+		std::memcpy(_cdata.data(), cdata, sizeof(stbtt_packedchar) * _cdata.size());
+		_build_data = BakedBitmap{ std::vector<std::uint8_t>(bitmap, bitmap + RANGE * RANGE) };
+	}
+
 	void Font::buildFont()
+	{
+		MLX_PROFILE_FUNCTION();
+		_bake = JobSystem::get().async([this]() { return bakeBitmap(); });
+	}
+
+	std::vector<std::uint8_t> Font::bakeBitmap()
 	{
 		MLX_PROFILE_FUNCTION();
 		std::vector<std::uint8_t> file_bytes;
@@ -39,7 +55,7 @@ namespace mlx
 			if(!file.is_open())
 			{
 				core::error::report(e_kind::error, "Font load : cannot open font file, %s", _name.c_str());
-				return;
+				return {};
 			}
 			std::ifstream::pos_type fileSize = std::filesystem::file_size(std::get<std::filesystem::path>(_build_data));
 			file.seekg(0, std::ios::beg);
@@ -50,13 +66,18 @@ namespace mlx
 
 		std::vector<std::uint8_t> tmp_bitmap(RANGE * RANGE);
 		std::vector<std::uint8_t> vulkan_bitmap(RANGE * RANGE * 4);
-		stbtt_pack_context pc;
-		stbtt_PackBegin(&pc, tmp_bitmap.data(), RANGE, RANGE, RANGE, 1, nullptr);
-		if(std::holds_alternative<std::filesystem::path>(_build_data))
-			stbtt_PackFontRange(&pc, file_bytes.data(), 0, _scale, 32, 96, _cdata.data());
+		if(std::holds_alternative<BakedBitmap>(_build_data))
+			tmp_bitmap = std::move(std::get<BakedBitmap>(_build_data).pixels);
 		else
-			stbtt_PackFontRange(&pc, std::get<std::vector<std::uint8_t>>(_build_data).data(), 0, _scale, 32, 96, _cdata.data());
-		stbtt_PackEnd(&pc);
+		{
+			stbtt_pack_context pc;
+			stbtt_PackBegin(&pc, tmp_bitmap.data(), RANGE, RANGE, RANGE, 1, nullptr);
+			if(std::holds_alternative<std::filesystem::path>(_build_data))
+				stbtt_PackFontRange(&pc, file_bytes.data(), 0, _scale, 32, 96, _cdata.data());
+			else
+				stbtt_PackFontRange(&pc, std::get<std::vector<std::uint8_t>>(_build_data).data(), 0, _scale, 32, 96, _cdata.data());
+			stbtt_PackEnd(&pc);
+		}
 		for(int i = 0, j = 0; i < RANGE * RANGE; i++, j += 4)
 		{
 			vulkan_bitmap[j + 0] = tmp_bitmap[i];
@@ -64,6 +85,18 @@ namespace mlx
 			vulkan_bitmap[j + 2] = tmp_bitmap[i];
 			vulkan_bitmap[j + 3] = tmp_bitmap[i];
 		}
+		return vulkan_bitmap;
+	}
+
+	void Font::finishBuild()
+	{
+		if(!_bake.isValid())
+			return;
+		MLX_PROFILE_FUNCTION();
+		std::vector<std::uint8_t> vulkan_bitmap = std::move(_bake.get());
+		_bake = {};
+		if(vulkan_bitmap.empty())
+			return;
 		#ifdef DEBUG
 			_atlas.create(vulkan_bitmap.data(), RANGE, RANGE, VK_FORMAT_R8G8B8A8_UNORM, std::string(_name + "_font_altas").c_str(), true);
 		#else
@@ -76,13 +109,19 @@ namespace mlx
 	void Font::destroy()
 	{
 		MLX_PROFILE_FUNCTION();
-		_atlas.destroy();
+		if(_bake.isValid()) // the job still uses the font
+		{
+			JobSystem::get().wait(_bake.getJob());
+			_bake = {};
+		}
+		if(_is_init)
+			_atlas.destroy();
 		_is_init = false;
 	}
 
 	Font::~Font()
 	{
-		if(_is_init)
+		if(_is_init || _bake.isValid())
 			destroy();
 	}
 }
@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/12/11 21:17:04 by kbz_8             #+#    #+#             */
-/*   Updated: 2024/01/18 13:15:55 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 03:11:53 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -17,6 +17,7 @@
 #include <stb_truetype.h>
 #include <renderer/images/texture_atlas.h>
 #include <utils/combine_hash.h>
+#include <core/job_system.h>
 #include <variant>
 
 namespace mlx
@@ -28,11 +29,12 @@ namespace mlx
 			Font() = delete;
 			Font(class Renderer& renderer, const std::filesystem::path& path, float scale);
 			Font(class Renderer& renderer, const std::string& name, const std::vector<std::uint8_t>& ttf_data, float scale);
+			Font(class Renderer& renderer, const std::string& name, float scale, const stbtt_packedchar* cdata, const std::uint8_t* bitmap); // already baked, single channel bitmap
 
 			inline const std::string& getName() const { return _name; }
 			inline float getScale() const noexcept { return _scale; }
-			inline const std::array<stbtt_packedchar, 96>& getCharData() const { return _cdata; }
-			inline const TextureAtlas& getAtlas() const noexcept { return _atlas; }
+			inline const std::array<stbtt_packedchar, 96>& getCharData() { finishBuild(); return _cdata; }
+			inline const TextureAtlas& getAtlas() { finishBuild(); return _atlas; }
 			inline bool operator==(const Font& rhs) const { return rhs._name == _name && rhs._scale == _scale; }
 			inline bool operator!=(const Font& rhs) const { return rhs._name != _name || rhs._scale != _scale; }
 			void destroy();
@@ -40,12 +42,21 @@ namespace mlx
 			~Font();
 
 		private:
-			void buildFont();
+			void buildFont(); // bakes the glyphs in a job, the atlas is uploaded when the font is first used
+			std::vector<std::uint8_t> bakeBitmap();
+			void finishBuild();
+
+		private:
+			struct BakedBitmap
+			{
+				std::vector<std::uint8_t> pixels;
+			};
 
 		private:
 			std::array<stbtt_packedchar, 96> _cdata;
 			TextureAtlas _atlas;
-			std::variant<std::filesystem::path, std::vector<std::uint8_t>> _build_data;
+			JobFuture<std::vector<std::uint8_t>> _bake;
+			std::variant<std::filesystem::path, std::vector<std::uint8_t>, BakedBitmap> _build_data;
 			std::string _name;
 			class Renderer& _renderer;
 			float _scale = 0;
@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/01/11 00:11:56 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/25 16:13:08 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 02:45:08 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -16,7 +16,7 @@
 
 namespace mlx
 {
-	void Text::init(std::string text, FontID font, std::uint32_t color, std::vector<Vertex> vbo_data, std::vector<std::uint16_t> ibo_data)
+	void Text::init(std::string text, FontID font, std::uint32_t color, std::vector<Vertex> vbo_data, std::vector<std::uint16_t> ibo_data, std::uint32_t frames_in_flight)
 	{
 		MLX_PROFILE_FUNCTION();
 		if(_is_init)
@@ -24,6 +24,7 @@ namespace mlx
 		_text = std::move(text);
 		_color = color;
 		_font = font;
+		_vbo = std::vector<D_VBO>(frames_in_flight);
 		#ifdef DEBUG
 			std::string debug_name = _text;
 			for(char& c : debug_name)
@@ -31,12 +32,12 @@ namespace mlx
 				if(c == ' ' || c == '"' || c == '\'')
 					c = '_';
 			}
-			for(int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
-				_vbo[i].create(sizeof(Vertex) * vbo_data.size(), static_cast<const void*>(vbo_data.data()), debug_name.c_str());
+			for(D_VBO& vbo : _vbo)
+				vbo.create(sizeof(Vertex) * vbo_data.size(), static_cast<const void*>(vbo_data.data()), debug_name.c_str());
 			_ibo.create(sizeof(std::uint16_t) * ibo_data.size(), ibo_data.data(), debug_name.c_str());
 		#else
-			for(int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
-				_vbo[i].create(sizeof(Vertex) * vbo_data.size(), static_cast<const void*>(vbo_data.data()), nullptr);
+			for(D_VBO& vbo : _vbo)
+				vbo.create(sizeof(Vertex) * vbo_data.size(), static_cast<const void*>(vbo_data.data()), nullptr);
 			_ibo.create(sizeof(std::uint16_t) * ibo_data.size(), ibo_data.data(), nullptr);
 		#endif
 		_is_init = true;
@@ -64,8 +65,9 @@ namespace mlx
 		MLX_PROFILE_FUNCTION();
 		if(!_is_init)
 			return;
-		for(int i = 0; i < MAX_FRAMES_IN_FLIGHT; i++)
-			_vbo[i].destroy();
+		for(D_VBO& vbo : _vbo)
+			vbo.destroy();
+		_vbo.clear();
 		_ibo.destroy();
 		_is_init = false;
 	}
@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/01/11 00:09:04 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/25 16:16:48 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 04:37:36 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -27,19 +27,20 @@ namespace mlx
 		public:
 			Text() = default;
 
-			void init(std::string text, FontID font, std::uint32_t color, std::vector<Vertex> vbo_data, std::vector<std::uint16_t> ibo_data);
+			void init(std::string text, FontID font, std::uint32_t color, std::vector<Vertex> vbo_data, std::vector<std::uint16_t> ibo_data, std::uint32_t frames_in_flight);
 			void bind(class Renderer& renderer) noexcept;
 			inline FontID getFontInUse() const noexcept { return _font; }
 			void updateVertexData(int frame, std::vector<Vertex> vbo_data);
 			inline std::uint32_t getIBOsize() noexcept { return _ibo.getSize(); }
 			inline const std::string& getText() const { return _text; }
 			inline std::uint32_t getColor() const noexcept { return _color; }
+			inline std::size_t getFramesInFlight() const noexcept { return _vbo.size(); }
 			void destroy() noexcept;
 
 			~Text();
 
 		private:
-			std::array<D_VBO, MAX_FRAMES_IN_FLIGHT> _vbo;
+			std::vector<D_VBO> _vbo;
 			C_IBO _ibo;
 			std::string _text;
 			std::uint32_t _color;
@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/01/11 00:23:11 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/25 16:13:48 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 02:53:36 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -20,6 +20,8 @@
 #include <stb_rect_pack.h>
 
 #include <core/memory.h>
+#include <algorithm>
+#include <cmath>
 
 #define STB_TRUETYPE_IMPLEMENTATION
 #define STB_malloc(x, u) ((void)(u), MemManager::malloc(x))
@@ -33,7 +35,7 @@ namespace mlx
 	TextDrawDescriptor::TextDrawDescriptor(std::string text, std::uint32_t _color, int _x, int _y) : color(_color), x(_x), y(_y), _text(std::move(text))
 	{}
 
-	void TextDrawDescriptor::init(FontID font) noexcept
+	void TextDrawDescriptor::init(FontID font, std::uint32_t frames_in_flight) noexcept
 	{
 		MLX_PROFILE_FUNCTION();
 		std::vector<Vertex> vertexData;
@@ -42,6 +44,11 @@ namespace mlx
 		float stb_x = 0.0f;
 		float stb_y = 0.0f;
 
+		float min_x = 0.0f;
+		float min_y = 0.0f;
+		float max_x = 0.0f;
+		float max_y = 0.0f;
+
 		{
 			std::shared_ptr<Font> font_data = FontLibrary::get().getFontData(font);
 
@@ -55,6 +62,18 @@ namespace mlx
 
 				std::size_t index = vertexData.size();
 
+				if(index == 0)
+				{
+					min_x = q.x0;
+					min_y = q.y0;
+					max_x = q.x1;
+					max_y = q.y1;
+				}
+				min_x = std::min(min_x, q.x0);
+				min_y = std::min(min_y, q.y0);
+				max_x = std::max(max_x, q.x1);
+				max_y = std::max(max_y, q.y1);
+
 				glm::vec4 vertex_color = {
 					static_cast<float>((color & 0x000000FF)) / 255.f,
 					static_cast<float>((color & 0x0000FF00) >> 8) / 255.f,
@@ -75,8 +94,11 @@ namespace mlx
 				indexData.emplace_back(index + 0);
 			}
 		}
+		_bounds.offset = { static_cast<std::int32_t>(std::floor(min_x)), static_cast<std::int32_t>(std::floor(min_y)) };
+		_bounds.extent = { static_cast<std::uint32_t>(std::ceil(max_x) - _bounds.offset.x), static_cast<std::uint32_t>(std::ceil(max_y) - _bounds.offset.y) };
+
 		std::shared_ptr<Text> text_data = std::make_shared<Text>();
-		text_data->init(_text, font, color, std::move(vertexData), std::move(indexData));
+		text_data->init(_text, font, color, std::move(vertexData), std::move(indexData), frames_in_flight);
 		id = TextLibrary::get().addTextToLibrary(text_data);
 
 		#ifdef DEBUG
@@ -100,6 +122,13 @@ namespace mlx
 		atlas.render(renderer, x, y, draw_data->getIBOsize());
 	}
 
+	std::size_t TextDrawDescriptor::getSignature() const noexcept
+	{
+		std::size_t hash = std::hash<TextDrawDescriptor>{}(*this);
+		hashCombine(hash, TextLibrary::get().getTextData(id)->getFontInUse());
+		return hash;
+	}
+
 	void TextDrawDescriptor::resetUpdate()
 	{
 		std::shared_ptr<Text> draw_data = TextLibrary::get().getTextData(id);
@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/01/11 00:13:34 by maldavid          #+#    #+#             */
-/*   Updated: 2024/02/25 07:58:13 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 02:53:36 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -37,15 +37,18 @@ namespace mlx
 		public:
 			TextDrawDescriptor(std::string text, std::uint32_t _color, int _x, int _y);
 
-			void init(FontID font) noexcept;
+			void init(FontID font, std::uint32_t frames_in_flight) noexcept;
 			bool operator==(const TextDrawDescriptor& rhs) const { return _text == rhs._text && x == rhs.x && y == rhs.y && color == rhs.color; }
 			void render(std::array<VkDescriptorSet, 2>& sets, Renderer& renderer) override;
 			void resetUpdate() override;
+			std::size_t getSignature() const noexcept override;
+			inline VkRect2D getBounds() const noexcept override { return { { _bounds.offset.x + x, _bounds.offset.y + y }, _bounds.extent }; }
 
 			TextDrawDescriptor() = default;
 
 		private:
 			std::string _text;
+			VkRect2D _bounds = { { 0, 0 }, { 0, 0 } }; // glyphs area relative to the text position
 	};
 }
 
@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/04/10 11:59:57 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/25 16:17:06 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 04:37:36 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -30,9 +30,10 @@ namespace mlx
 	TextID TextLibrary::addTextToLibrary(std::shared_ptr<Text> text)
 	{
 		MLX_PROFILE_FUNCTION();
+		// windows may have different frames in flight counts, a text only has vertex buffers for the one it was created with
 		auto it = std::find_if(_cache.begin(), _cache.end(), [&](const std::pair<TextID, std::shared_ptr<Text>>& v)
 		{
-			return v.second->getText() == text->getText() && v.second->getColor() == text->getColor();
+			return v.second->getText() == text->getText() && v.second->getColor() == text->getColor() && v.second->getFramesInFlight() == text->getFramesInFlight();
 		});
 		if(it != _cache.end())
 			return it->first;
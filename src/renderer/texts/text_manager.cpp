@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/04/06 16:41:13 by maldavid          #+#    #+#             */
-/*   Updated: 2024/02/25 09:29:36 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 03:11:53 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -23,6 +23,7 @@ namespace mlx
 	void TextManager::init(Renderer& renderer) noexcept
 	{
 		MLX_PROFILE_FUNCTION();
+		_frames_in_flight = renderer.getFramesInFlight();
 		loadFont(renderer, "default", 6.f);
 	}
 
@@ -38,13 +39,19 @@ namespace mlx
 		_font_in_use = FontLibrary::get().addFontToLibrary(font);
 	}
 
+	void TextManager::loadFont(std::shared_ptr<Font> font)
+	{
+		MLX_PROFILE_FUNCTION();
+		_font_in_use = FontLibrary::get().addFontToLibrary(font);
+	}
+
 	std::pair<DrawableResource*, bool> TextManager::registerText(int x, int y, std::uint32_t color, std::string str)
 	{
 		MLX_PROFILE_FUNCTION();
 		auto res = _text_descriptors.emplace(std::move(str), color, x, y);
 		if(res.second)
 		{
-			const_cast<TextDrawDescriptor&>(*res.first).init(_font_in_use);
+			const_cast<TextDrawDescriptor&>(*res.first).init(_font_in_use, _frames_in_flight);
 			return std::make_pair(static_cast<DrawableResource*>(&const_cast<TextDrawDescriptor&>(*res.first)), true);
 		}
 
@@ -53,7 +60,7 @@ namespace mlx
 		{
 			// TODO : update text vertex buffers rather than destroying it and recreating it
 			TextLibrary::get().removeTextFromLibrary(res.first->id);
-			const_cast<TextDrawDescriptor&>(*res.first).init(_font_in_use);
+			const_cast<TextDrawDescriptor&>(*res.first).init(_font_in_use, _frames_in_flight);
 		}
 		return std::make_pair(static_cast<DrawableResource*>(&const_cast<TextDrawDescriptor&>(*res.first)), false);
 	}
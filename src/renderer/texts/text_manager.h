@@ -6,7 +6,7 @@
 /*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2023/04/06 16:24:11 by maldavid          #+#    #+#             */
-/*   Updated: 2024/03/14 17:08:43 by maldavid         ###   ########.fr       */
+/*   Updated: 2026/10/19 03:11:53 by maldavid         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
@@ -35,6 +35,7 @@ namespace mlx
 			std::pair<DrawableResource*, bool> registerText(int x, int y, std::uint32_t color, std::string str);
 			inline void clear() { _text_descriptors.clear(); }
 			void loadFont(Renderer& renderer, const std::filesystem::path& filepath, float scale);
+			void loadFont(std::shared_ptr<class Font> font);
 			void destroy() noexcept;
 
 			~TextManager() = default;
@@ -42,6 +43,7 @@ namespace mlx
 		private:
 			std::unordered_set<TextDrawDescriptor> _text_descriptors;
 			FontID _font_in_use = nullfont;
+			std::uint32_t _frames_in_flight = DEFAULT_FRAMES_IN_FLIGHT;
 	};
 }
 
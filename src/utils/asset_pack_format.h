@@ -0,0 +1,89 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   asset_pack_format.h                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 03:08:54 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/19 03:11:53 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef __MLX_ASSET_PACK_FORMAT__
+#define __MLX_ASSET_PACK_FORMAT__
+
+#include <cstdint>
+
+// Layout of the asset packs written by tools/packer and mapped by the runtime.
+// Everything is stored in the host byte order, offsets are from the beginning of the file.
+//
+//  Header
+//  Entry[entries_count]     sorted by name
+//  Region[regions_count]    sub images of the atlases, sorted by name
+//  names                    not null terminated
+//  data                     pixels and glyphs, each block aligned on DATA_ALIGNMENT
+
+namespace mlx::pack
+{
+	constexpr const std::uint32_t MAGIC = 0x50584C4D; // "MLXP"
+	constexpr const std::uint32_t VERSION = 1;
+	constexpr const std::uint64_t DATA_ALIGNMENT = 16;
+	constexpr const std::uint32_t FONT_ATLAS_SIZE = 1024; // fonts are baked like Font::buildFont does
+	constexpr const std::uint32_t FONT_FIRST_CHAR = 32;
+	constexpr const std::uint32_t FONT_CHARS_COUNT = 96;
+
+	enum class EntryKind : std::uint32_t
+	{
+		image = 0, // RGBA pixels, may be an atlas of regions
+		font = 1,  // single channel atlas followed by FONT_CHARS_COUNT glyphs
+	};
+
+	struct Header
+	{
+		std::uint32_t magic;
+		std::uint32_t version;
+		std::uint32_t entries_count;
+		std::uint32_t regions_count;
+		std::uint64_t entries_offset;
+		std::uint64_t regions_offset;
+		std::uint64_t names_offset;
+		std::uint64_t names_size;
+	};
+
+	struct Entry
+	{
+		std::uint32_t kind;
+		std::uint32_t width;
+		std::uint32_t height;
+		std::uint32_t name_offset; // from names_offset
+		std::uint32_t name_size;
+		float scale;               // fonts only
+		std::uint64_t data_offset;
+		std::uint64_t data_size;
+		std::uint64_t glyphs_offset; // fonts only
+	};
+
+	struct Region
+	{
+		std::uint32_t name_offset;
+		std::uint32_t name_size;
+		std::uint32_t entry; // index of the atlas
+		std::uint32_t x;
+		std::uint32_t y;
+		std::uint32_t width;
+		std::uint32_t height;
+		std::uint32_t padding;
+	};
+
+	struct Glyph // same layout as stbtt_packedchar
+	{
+		std::uint16_t x0, y0, x1, y1;
+		float xoff, yoff, xadvance;
+		float xoff2, yoff2;
+	};
+
+	static_assert(sizeof(Header) == 48 && sizeof(Entry) == 48 && sizeof(Region) == 32 && sizeof(Glyph) == 28, "asset pack structures must not be padded");
+}
+
+#endif
@@ -0,0 +1,58 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   rect.h                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 02:51:03 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/19 02:53:36 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#ifndef __MLX_RECT__
+#define __MLX_RECT__
+
+#include <mlx_profile.h>
+#include <volk.h>
+#include <algorithm>
+#include <cstdint>
+
+namespace mlx
+{
+	inline bool rectIsEmpty(const VkRect2D& rect) noexcept
+	{
+		return rect.extent.width == 0 || rect.extent.height == 0;
+	}
+
+	inline VkRect2D rectUnion(const VkRect2D& a, const VkRect2D& b) noexcept
+	{
+		if(rectIsEmpty(a))
+			return b;
+		if(rectIsEmpty(b))
+			return a;
+		std::int64_t x0 = std::min(a.offset.x, b.offset.x);
+		std::int64_t y0 = std::min(a.offset.y, b.offset.y);
+		std::int64_t x1 = std::max(a.offset.x + static_cast<std::int64_t>(a.extent.width), b.offset.x + static_cast<std::int64_t>(b.extent.width));
+		std::int64_t y1 = std::max(a.offset.y + static_cast<std::int64_t>(a.extent.height), b.offset.y + static_cast<std::int64_t>(b.extent.height));
+		return { { static_cast<std::int32_t>(x0), static_cast<std::int32_t>(y0) }, { static_cast<std::uint32_t>(x1 - x0), static_cast<std::uint32_t>(y1 - y0) } };
+	}
+
+	inline VkRect2D rectIntersection(const VkRect2D& a, const VkRect2D& b) noexcept
+	{
+		std::int64_t x0 = std::max(a.offset.x, b.offset.x);
+		std::int64_t y0 = std::max(a.offset.y, b.offset.y);
+		std::int64_t x1 = std::min(a.offset.x + static_cast<std::int64_t>(a.extent.width), b.offset.x + static_cast<std::int64_t>(b.extent.width));
+		std::int64_t y1 = std::min(a.offset.y + static_cast<std::int64_t>(a.extent.height), b.offset.y + static_cast<std::int64_t>(b.extent.height));
+		if(x1 <= x0 || y1 <= y0)
+			return { { 0, 0 }, { 0, 0 } };
+		return { { static_cast<std::int32_t>(x0), static_cast<std::int32_t>(y0) }, { static_cast<std::uint32_t>(x1 - x0), static_cast<std::uint32_t>(y1 - y0) } };
+	}
+
+	inline bool rectIntersects(const VkRect2D& a, const VkRect2D& b) noexcept
+	{
+		return !rectIsEmpty(rectIntersection(a, b));
+	}
+}
+
+#endif
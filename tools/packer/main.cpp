@@ -0,0 +1,337 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   main.cpp                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: maldavid <kbz_8.dev@akel-engine.com>       +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/19 03:11:13 by maldavid          #+#    #+#             */
+/*   Updated: 2026/10/19 03:11:53 by maldavid         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+// Offline packer of the MLX asset packs, see src/utils/asset_pack_format.h
+//
+// usage: mlx_packer <output> [images...] [--atlas <name> images...] [--font <file.ttf> <scale>] [--images images...]
+//
+// Images are stored decoded in RGBA under the path given on the command line.
+// The images following `--atlas <name>` are packed together in the atlas image `name`
+// and can be found by their own path as regions of it, until the next option.
+// Fonts are baked the same way as the MLX does at runtime.
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include <utils/asset_pack_format.h>
+
+#define STB_IMAGE_IMPLEMENTATION
+#include <stb_image.h>
+#define STB_RECT_PACK_IMPLEMENTATION
+#include <stb_rect_pack.h>
+#define STB_TRUETYPE_IMPLEMENTATION
+#include <stb_truetype.h>
+
+namespace
+{
+	constexpr const int ATLAS_PADDING = 1;
+	constexpr const int ATLAS_MAX_SIZE = 16384;
+
+	struct Image
+	{
+		std::string path;
+		std::vector<std::uint8_t> pixels;
+		int width = 0;
+		int height = 0;
+	};
+
+	struct Atlas
+	{
+		std::string name;
+		std::vector<Image> images;
+	};
+
+	struct Font
+	{
+		std::string path;
+		float scale = 0.f;
+	};
+
+	struct Entry
+	{
+		std::string name;
+		mlx::pack::Entry header{};
+		std::vector<std::uint8_t> data;
+		std::vector<mlx::pack::Glyph> glyphs;
+	};
+
+	struct Region
+	{
+		std::string name;
+		std::string atlas;
+		mlx::pack::Region header{};
+	};
+
+	[[noreturn]] void fail(const char* format, const char* arg)
+	{
+		std::fprintf(stderr, "mlx_packer: ");
+		std::fprintf(stderr, format, arg);
+		std::fprintf(stderr, "\n");
+		std::exit(EXIT_FAILURE);
+	}
+
+	Image loadImage(const std::string& path)
+	{
+		Image image;
+		image.path = path;
+		int channels;
+		std::uint8_t* data = stbi_load(path.c_str(), &image.width, &image.height, &channels, 4);
+		if(data == nullptr)
+			fail("cannot load image '%s'", path.c_str());
+		image.pixels.assign(data, data + static_cast<std::size_t>(image.width) * image.height * 4);
+		stbi_image_free(data);
+		return image;
+	}
+
+	Entry makeImageEntry(const Image& image)
+	{
+		Entry entry;
+		entry.name = image.path;
+		entry.header.kind = static_cast<std::uint32_t>(mlx::pack::EntryKind::image);
+		entry.header.width = image.width;
+		entry.header.height = image.height;
+		entry.data = image.pixels;
+		return entry;
+	}
+
+	Entry makeAtlasEntry(const Atlas& atlas, std::vector<Region>& regions)
+	{
+		std::vector<stbrp_rect> rects(atlas.images.size());
+		for(std::size_t i = 0; i < rects.size(); i++)
+		{
+			rects[i].id = static_cast<int>(i);
+			rects[i].w = atlas.images[i].width + ATLAS_PADDING;
+			rects[i].h = atlas.images[i].height + ATLAS_PADDING;
+		}
+
+		// grows the atlas until everything fits
+		int width = 64;
+		int height = 64;
+		for(;;)
+		{
+			std::vector<stbrp_node> nodes(width);
+			stbrp_context context;
+			stbrp_init_target(&context, width, height, nodes.data(), static_cast<int>(nodes.size()));
+			if(stbrp_pack_rects(&context, rects.data(), static_cast<int>(rects.size())))
+				break;
+			if(width == ATLAS_MAX_SIZE && height == ATLAS_MAX_SIZE)
+				fail("atlas '%s' does not fit in 16384x16384", atlas.name.c_str());
+			if(width <= height)
+				width *= 2;
+			else
+				height *= 2;
+		}
+
+		Entry entry;
+		entry.name = atlas.name;
+		entry.header.kind = static_cast<std::uint32_t>(mlx::pack::EntryKind::image);
+		entry.header.width = width;
+		entry.header.height = height;
+		entry.data.assign(static_cast<std::size_t>(width) * height * 4, 0);
+		for(const stbrp_rect& rect : rects)
+		{
+			const Image& image = atlas.images[rect.id];
+			for(int y = 0; y < image.height; y++)
+				std::memcpy(&entry.data[(static_cast<std::size_t>(rect.y + y) * width + rect.x) * 4], &image.pixels[static_cast<std::size_t>(y) * image.width * 4], static_cast<std::size_t>(image.width) * 4);
+
+			Region& region = regions.emplace_back();
+			region.name = image.path;
+			region.atlas = atlas.name;
+			region.header.x = rect.x;
+			region.header.y = rect.y;
+			region.header.width = image.width;
+			region.header.height = image.height;
+		}
+		return entry;
+	}
+
+	Entry makeFontEntry(const Font& font)
+	{
+		std::ifstream file(font.path, std::ios::binary);
+		if(!file.is_open())
+			fail("cannot open font '%s'", font.path.c_str());
+		std::vector<std::uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+
+		Entry entry;
+		entry.name = font.path;
+		entry.header.kind = static_cast<std::uint32_t>(mlx::pack::EntryKind::font);
+		entry.header.width = mlx::pack::FONT_ATLAS_SIZE;
+		entry.header.height = mlx::pack::FONT_ATLAS_SIZE;
+		entry.header.scale = font.scale;
+		entry.data.resize(static_cast<std::size_t>(mlx::pack::FONT_ATLAS_SIZE) * mlx::pack::FONT_ATLAS_SIZE);
+		entry.glyphs.resize(mlx::pack::FONT_CHARS_COUNT);
+
+		stbtt_pack_context pc;
+		if(!stbtt_PackBegin(&pc, entry.data.data(), mlx::pack::FONT_ATLAS_SIZE, mlx::pack::FONT_ATLAS_SIZE, mlx::pack::FONT_ATLAS_SIZE, 1, nullptr))
+			fail("cannot bake font '%s'", font.path.c_str());
+		if(!stbtt_PackFontRange(&pc, bytes.data(), 0, font.scale, mlx::pack::FONT_FIRST_CHAR, mlx::pack::FONT_CHARS_COUNT, reinterpret_cast<stbtt_packedchar*>(entry.glyphs.data())))
+			fail("cannot bake font '%s'", font.path.c_str());
+		stbtt_PackEnd(&pc);
+		return entry;
+	}
+
+	std::uint64_t align(std::uint64_t offset, std::uint64_t alignment)
+	{
+		return (offset + alignment - 1) / alignment * alignment;
+	}
+
+	void write(const std::string& output, std::vector<Entry>& entries, std::vector<Region>& regions)
+	{
+		// sorted so the runtime can look names up without building any index
+		std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.name < b.name; });
+		std::sort(regions.begin(), regions.end(), [](const Region& a, const Region& b) { return a.name < b.name; });
+		for(std::size_t i = 1; i < entries.size(); i++)
+		{
+			if(entries[i].name == entries[i - 1].name)
+				fail("'%s' is packed twice", entries[i].name.c_str());
+		}
+		for(std::size_t i = 1; i < regions.size(); i++)
+		{
+			if(regions[i].name == regions[i - 1].name)
+				fail("'%s' is packed twice", regions[i].name.c_str());
+		}
+
+		std::string names;
+		for(Entry& entry : entries)
+		{
+			entry.header.name_offset = static_cast<std::uint32_t>(names.size());
+			entry.header.name_size = static_cast<std::uint32_t>(entry.name.size());
+			names += entry.name;
+		}
+		for(Region& region : regions)
+		{
+			region.header.name_offset = static_cast<std::uint32_t>(names.size());
+			region.header.name_size = static_cast<std::uint32_t>(region.name.size());
+			names += region.name;
+			auto atlas = std::find_if(entries.begin(), entries.end(), [&](const Entry& entry) { return entry.name == region.atlas; });
+			region.header.entry = static_cast<std::uint32_t>(atlas - entries.begin());
+		}
+
+		mlx::pack::Header header{};
+		header.magic = mlx::pack::MAGIC;
+		header.version = mlx::pack::VERSION;
+		header.entries_count = static_cast<std::uint32_t>(entries.size());
+		header.regions_count = static_cast<std::uint32_t>(regions.size());
+		header.entries_offset = sizeof(mlx::pack::Header);
+		header.regions_offset = header.entries_offset + entries.size() * sizeof(mlx::pack::Entry);
+		header.names_offset = header.regions_offset + regions.size() * sizeof(mlx::pack::Region);
+		header.names_size = names.size();
+
+		std::uint64_t offset = header.names_offset + header.names_size;
+		for(Entry& entry : entries)
+		{
+			offset = align(offset, mlx::pack::DATA_ALIGNMENT);
+			entry.header.data_offset = offset;
+			entry.header.data_size = entry.data.size();
+			offset += entry.data.size();
+			if(!entry.glyphs.empty())
+			{
+				offset = align(offset, mlx::pack::DATA_ALIGNMENT);
+				entry.header.glyphs_offset = offset;
+				offset += entry.glyphs.size() * sizeof(mlx::pack::Glyph);
+			}
+		}
+
+		std::ofstream file(output, std::ios::binary | std::ios::trunc);
+		if(!file.is_open())
+			fail("cannot create '%s'", output.c_str());
+		auto pad = [&](std::uint64_t to)
+		{
+			static const char zeros[mlx::pack::DATA_ALIGNMENT] = {};
+			file.write(zeros, static_cast<std::streamsize>(to - static_cast<std::uint64_t>(file.tellp())));
+		};
+		file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		for(const Entry& entry : entries)
+			file.write(reinterpret_cast<const char*>(&entry.header), sizeof(entry.header));
+		for(const Region& region : regions)
+			file.write(reinterpret_cast<const char*>(&region.header), sizeof(region.header));
+		file.write(names.data(), static_cast<std::streamsize>(names.size()));
+		for(const Entry& entry : entries)
+		{
+			pad(entry.header.data_offset);
+			file.write(reinterpret_cast<const char*>(entry.data.data()), static_cast<std::streamsize>(entry.data.size()));
+			if(!entry.glyphs.empty())
+			{
+				pad(entry.header.glyphs_offset);
+				file.write(reinterpret_cast<const char*>(entry.glyphs.data()), static_cast<std::streamsize>(entry.glyphs.size() * sizeof(mlx::pack::Glyph)));
+			}
+		}
+		if(!file.good())
+			fail("cannot write '%s'", output.c_str());
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if(argc < 3)
+	{
+		std::fprintf(stderr, "usage: %s <output> [images...] [--atlas <name> images...] [--font <file.ttf> <scale>] [--images images...]\n", argv[0]);
+		return EXIT_FAILURE;
+	}
+
+	std::vector<Image> images;
+	std::vector<Atlas> atlases;
+	std::vector<Font> fonts;
+	Atlas* current_atlas = nullptr;
+	for(int i = 2; i < argc; i++)
+	{
+		std::string arg = argv[i];
+		if(arg == "--atlas")
+		{
+			if(i + 1 >= argc)
+				fail("%s needs a name", "--atlas");
+			current_atlas = &atlases.emplace_back();
+			current_atlas->name = argv[++i];
+		}
+		else if(arg == "--font")
+		{
+			if(i + 2 >= argc)
+				fail("%s needs a file and a scale", "--font");
+			Font& font = fonts.emplace_back();
+			font.path = argv[++i];
+			font.scale = std::strtof(argv[++i], nullptr);
+			if(font.scale <= 0.f)
+				fail("invalid scale for font '%s'", font.path.c_str());
+			current_atlas = nullptr;
+		}
+		else if(arg == "--images")
+			current_atlas = nullptr;
+		else if(current_atlas != nullptr)
+			current_atlas->images.push_back(loadImage(arg));
+		else
+			images.push_back(loadImage(arg));
+	}
+
+	std::vector<Entry> entries;
+	std::vector<Region> regions;
+	for(const Image& image : images)
+		entries.push_back(makeImageEntry(image));
+	for(const Atlas& atlas : atlases)
+	{
+		if(atlas.images.empty())
+			fail("atlas '%s' is empty", atlas.name.c_str());
+		entries.push_back(makeAtlasEntry(atlas, regions));
+	}
+	for(const Font& font : fonts)
+		entries.push_back(makeFontEntry(font));
+
+	write(argv[1], entries, regions);
+	std::printf("mlx_packer: %zu images, %zu atlases, %zu fonts written to '%s'\n", images.size(), atlases.size(), fonts.size(), argv[1]);
+	return EXIT_SUCCESS;
+}
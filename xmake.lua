@@ -66,6 +66,14 @@ target("mlx")
 	end
 target_end() -- optional but I think the code is cleaner with this -- optional but I think the code is cleaner with this
 
+target("packer")
+	set_default(false)
+	set_kind("binary")
+	set_basename("mlx_packer")
+	add_includedirs("src", "third_party")
+	add_files("tools/packer/main.cpp")
+target_end()
+
 target("Test")
 	set_default(false)
 	set_kind("binary")